@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchReport.h"
+#include "Benchmark.h"
+#include "CustomerOrder.h"
+#include "LineManager.h"
+#include "OutputBuffer.h"
+#include "ReportWriter.h"
+#include "Station.h"
+#include "Utilities.h"
+#include "Workload.h"
+#include "Workstation.h"
+
+using namespace seneca;
+
+namespace {
+    const std::string c_stationRecord = "Office Chair,147852,20,High-back carpet-rollers";
+    const std::string c_orderRecord = "Cornel B.|1-Room Home Office|Office Chair|Desk|Bookcase|Bookcase|Filing Cabinet";
+
+    // Keeps results the compiler could otherwise prove unused
+    volatile size_t g_sink = 0;
+
+    // Benchmarks that consume their orders prepare them in chunks of this
+    // size, so memory stays flat however long they run
+    const size_t c_chunk = 4096;
+
+    // Uses the standard library alone, so its speed follows the host rather
+    // than this code; comparisons scale throughput by it
+    const std::string c_referenceBenchmark = "Reference (std::getline split)";
+
+    void benchReference(size_t count, BenchTimer& timer) {
+        size_t fields = 0;
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            std::istringstream record(c_stationRecord);
+            std::vector<std::string> tokens;
+            std::string token;
+            while (std::getline(record, token, ',')) tokens.push_back(token);
+            fields += tokens.size();
+        }
+        timer.stop();
+        g_sink = fields;
+    }
+
+    void benchExtractToken(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter(',');
+        Utilities util;
+        size_t fields = 0;
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            size_t next_pos = 0;
+            bool more = true;
+            while (more) {
+                fields += util.extractToken(c_stationRecord, next_pos, more).size();
+            }
+        }
+        timer.stop();
+        g_sink = fields;
+    }
+
+    void benchStationConstructor(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter(',');
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            Station station(c_stationRecord);
+        }
+        timer.stop();
+    }
+
+    void benchOrderConstructor(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter('|');
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            CustomerOrder order(c_orderRecord);
+        }
+        timer.stop();
+    }
+
+    // Fills the last of an order's five items, so every call scans the order
+    void benchFillItem(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter(',');
+        Station station("Filing Cabinet,1,2000000000,Three drawers");
+        Utilities::setDelimiter('|');
+        std::ostream discard(nullptr);
+
+        for (size_t done = 0; done < count; done += c_chunk) {
+            std::vector<CustomerOrder> orders;
+            orders.reserve(c_chunk);
+            for (size_t i = done; i < count && i < done + c_chunk; i++) orders.emplace_back(c_orderRecord);
+
+            timer.start();
+            for (auto& order : orders) {
+                order.fillItem(station, discard);
+            }
+            timer.stop();
+        }
+    }
+
+    // Moves orders that need nothing from the first station on to the second
+    void benchAttemptToMoveOrder(size_t count, BenchTimer& timer) {
+        for (size_t done = 0; done < count; done += c_chunk) {
+            Utilities::setDelimiter(',');
+            Workstation first("Lamp,1,5,Desk lamp");
+            Workstation second("Rug,1,5,Area rug");
+            first.setNextStation(&second);
+            Utilities::setDelimiter('|');
+            size_t chunk = std::min(c_chunk, count - done);
+            for (size_t i = 0; i < chunk; i++) first += CustomerOrder(c_orderRecord);
+
+            timer.start();
+            for (size_t i = 0; i < chunk; i++) {
+                first.attemptToMoveOrder();
+            }
+            timer.stop();
+        }
+    }
+
+    // The pretty results output, one order at a time
+    void benchOrderDisplay(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter('|');
+        CustomerOrder order(c_orderRecord);
+        std::ostringstream os;
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            order.display(os);
+            if (os.tellp() > (1 << 20)) os.str("");
+        }
+        timer.stop();
+    }
+
+    // The same, into one buffer for the whole listing as the result paths do
+    void benchOrderDisplayBuffered(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter('|');
+        CustomerOrder order(c_orderRecord);
+        std::ostream discard(nullptr);
+        OutputBuffer output(discard);
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            order.display(output);
+        }
+        output.flush();
+        timer.stop();
+    }
+
+    // The same order as a CSV report
+    void benchReportOrder(size_t count, BenchTimer& timer) {
+        Utilities::setDelimiter('|');
+        CustomerOrder order(c_orderRecord);
+        std::ostream discard(nullptr);
+        ReportWriter writer(discard, ReportFormat::Csv);
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            writer.writeOrder(order, false);
+        }
+        writer.flush();
+        timer.stop();
+    }
+
+    // Builds a 100-station LineManager from an AssemblyLine file
+    void benchLineManagerConstructor(size_t count, BenchTimer& timer) {
+        const size_t stationCount = 100;
+        Utilities::setDelimiter(',');
+        std::vector<std::unique_ptr<Workstation>> owned;
+        std::vector<Workstation*> stations;
+        for (size_t i = 0; i < stationCount; i++) {
+            owned.push_back(std::make_unique<Workstation>("Item" + std::to_string(i) + ",1,5,Synthetic item"));
+            stations.push_back(owned.back().get());
+        }
+
+        std::string file = (std::filesystem::temp_directory_path() / "factory_bench_line.txt").string();
+        {
+            std::ofstream line(file);
+            for (size_t i = 0; i < stationCount; i++) {
+                line << "Item" << i;
+                if (i + 1 < stationCount) line << "|Item" << i + 1;
+                line << "\n";
+            }
+        }
+
+        Utilities::setDelimiter('|');
+        timer.start();
+        for (size_t i = 0; i < count; i++) {
+            LineManager manager(file, stations);
+            manager.reorderStations();
+        }
+        timer.stop();
+        std::remove(file.c_str());
+    }
+
+    BenchResult runMacro(size_t orders, size_t stations) {
+        bool peakRss = resetPeakRss();
+        GeneratorSpec spec;
+        spec.m_orders = orders;
+        spec.m_itemTypes = stations;
+        spec.m_minItems = 5;
+        spec.m_maxItems = 5;
+        spec.m_stock = 0.9;
+        Workload workload(spec);
+        LineManager manager(workload.getLine());
+
+        std::ostream discard(nullptr);
+        BenchTimer timer;
+        timer.start();
+        while (!manager.run(discard));
+        timer.stop();
+
+        BenchResult result;
+        result.m_name = "run/orders=" + std::to_string(orders) + ",stations=" + std::to_string(stations);
+        result.m_operations = orders;
+        result.m_items = workload.getItemCount();
+        result.m_iterations = manager.getIterationCount();
+        result.m_seconds = timer.getSeconds();
+        result.m_allocations = timer.getAllocations();
+        result.m_bytes = timer.getBytes();
+        result.m_peakRss = peakRss ? getPeakRssKilobytes() : 0;
+        result.m_counters = timer.getCounters();
+        return result;
+    }
+
+    std::vector<size_t> parseSizes(const std::string& list) {
+        std::vector<size_t> sizes;
+        std::stringstream ss(list);
+        std::string size;
+        while (std::getline(ss, size, ',')) sizes.push_back(std::stoul(size));
+        return sizes;
+    }
+
+    std::string readFile(const std::string& file) {
+        std::ifstream input(file, std::ios::binary);
+        if (!input) {
+            throw std::string("Unable to open ") + file;
+        }
+        std::ostringstream contents;
+        contents << input.rdbuf();
+        return contents.str();
+    }
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --micro               micro benchmarks only\n"
+                  << "  --macro               full runs only\n"
+                  << "  --orders n1,n2,...    order counts for full runs\n"
+                  << "  --stations n1,n2,...  line lengths for full runs (every pair is run)\n"
+                  << "  --min-time <seconds>  minimum timed duration of each micro benchmark (default 0.2)\n"
+                  << "  --quick               short micro benchmarks and small full runs, as CTest uses\n"
+                  << "  --json <file>         write the results as JSON (the baseline format)\n"
+                  << "  --baseline <file>     compare with a baseline; exit 3 on any regression\n"
+                  << "  --max-allocs-per-order <n>\n"
+                  << "                        exit 3 if a full run allocates more than n times per order\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool micro = true;
+    bool macro = true;
+    bool quick = false;
+    double minTime = 0.2;
+    std::vector<size_t> orders;
+    std::vector<size_t> stations;
+    std::string jsonFile;
+    std::string baselineFile;
+    double maxAllocationsPerOrder = -1;
+
+    SENECA_MEMORY_REPORT_AT_EXIT();
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "--micro") {
+                macro = false;
+            }
+            else if (option == "--macro") {
+                micro = false;
+            }
+            else if (option == "--quick") {
+                quick = true;
+                minTime = 0.05;
+            }
+            else if (option == "--orders" && i + 1 < argc) {
+                orders = parseSizes(argv[++i]);
+            }
+            else if (option == "--stations" && i + 1 < argc) {
+                stations = parseSizes(argv[++i]);
+            }
+            else if (option == "--min-time" && i + 1 < argc) {
+                minTime = std::stod(argv[++i]);
+            }
+            else if (option == "--json" && i + 1 < argc) {
+                jsonFile = argv[++i];
+            }
+            else if (option == "--baseline" && i + 1 < argc) {
+                baselineFile = argv[++i];
+            }
+            else if (option == "--max-allocs-per-order" && i + 1 < argc) {
+                maxAllocationsPerOrder = std::stod(argv[++i]);
+            }
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch (const std::logic_error&) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        // Read the baseline first so a bad path fails before the long part
+        JsonValue baseline;
+        if (!baselineFile.empty()) {
+            baseline = parseJson(readFile(baselineFile));
+        }
+
+        std::cout << "Factory Assembly Line Benchmarks (" << BENCH_BUILD_TYPE << " build)\n";
+        if (std::string(BENCH_BUILD_TYPE) != "Release") {
+            std::cout << "Note: configure with -DCMAKE_BUILD_TYPE=Release for representative numbers\n";
+        }
+
+        // Run in every mode so a baseline comparison always has it
+        BenchResult reference = runMicro(c_referenceBenchmark, benchReference, minTime);
+
+        std::vector<BenchResult> all;
+        if (micro) {
+            std::vector<BenchResult> results{reference};
+            results.push_back(runMicro("Utilities::extractToken (record)", benchExtractToken, minTime));
+            results.push_back(runMicro("Station::Station", benchStationConstructor, minTime));
+            results.push_back(runMicro("CustomerOrder::CustomerOrder", benchOrderConstructor, minTime));
+            results.push_back(runMicro("CustomerOrder::fillItem", benchFillItem, minTime));
+            results.push_back(runMicro("Workstation::attemptToMoveOrder", benchAttemptToMoveOrder, minTime));
+            results.push_back(runMicro("LineManager::LineManager (100)", benchLineManagerConstructor, minTime));
+            results.push_back(runMicro("CustomerOrder::display", benchOrderDisplay, minTime));
+            results.push_back(runMicro("CustomerOrder::display (buffered)", benchOrderDisplayBuffered, minTime));
+            results.push_back(runMicro("ReportWriter::writeOrder (csv)", benchReportOrder, minTime));
+            std::cout << "\n";
+            writeMicroTable(std::cout, results);
+            all.insert(all.end(), results.begin(), results.end());
+        }
+        else {
+            all.push_back(reference);
+        }
+
+        if (macro) {
+            // By default a spread of sizes that finishes in seconds; every pair
+            // of --orders and --stations is run when either is given
+            std::vector<std::pair<size_t, size_t>> runs;
+            if (orders.empty() && stations.empty()) {
+                if (quick) {
+                    runs = {{1000, 10}, {10000, 10}, {1000, 100}};
+                }
+                else {
+                    runs = {{1000, 10}, {10000, 10}, {100000, 10}, {10000, 100}, {100000, 100}, {1000, 1000}};
+                }
+            }
+            else {
+                if (orders.empty()) orders = {1000};
+                if (stations.empty()) stations = {10};
+                for (size_t orderCount : orders) {
+                    for (size_t stationCount : stations) runs.emplace_back(orderCount, stationCount);
+                }
+            }
+
+            std::vector<BenchResult> results;
+            for (const auto& run : runs) {
+                results.push_back(runMacro(run.first, run.second));
+            }
+            std::cout << "\n";
+            writeMacroTable(std::cout, results);
+            all.insert(all.end(), results.begin(), results.end());
+
+            // Orders are built before the timer starts, so what remains is
+            // the line itself: queue growth and anything a change adds per order
+            if (maxAllocationsPerOrder >= 0) {
+                size_t over = 0;
+                std::cout << "\nAllocations per order processed (budget " << maxAllocationsPerOrder << "):\n";
+                for (const auto& result : results) {
+                    bool exceeded = result.getAllocationsPerOperation() > maxAllocationsPerOrder;
+                    std::cout << (exceeded ? "OVER BUDGET " : "ok          ") << result.m_name << "  "
+                              << result.getAllocationsPerOperation() << "\n";
+                    if (exceeded) over++;
+                }
+                if (over > 0) {
+                    std::cout << "\n" << over << " run(s) over the allocation budget\n";
+                    return 3;
+                }
+            }
+        }
+
+        std::cout << "\n";
+        writeCounterTable(std::cout, all);
+
+        if (!jsonFile.empty()) {
+            std::ofstream json(jsonFile, std::ios::trunc);
+            if (!json) {
+                throw std::string("Unable to open ") + jsonFile;
+            }
+            writeResultsJson(json, all, BENCH_BUILD_TYPE, baselineFile.empty() ? nullptr : &baseline);
+            std::cout << "\nResults written to " << jsonFile << "\n";
+        }
+
+        if (!baselineFile.empty()) {
+            std::cout << "\nComparison with " << baselineFile << ":\n";
+            size_t regressions = compareWithBaseline(std::cout, all, baseline, BENCH_BUILD_TYPE,
+                c_referenceBenchmark);
+            if (regressions > 0) {
+                std::cout << "\n" << regressions << " regression(s) against the baseline\n";
+                return 3;
+            }
+            std::cout << "\nNo regressions\n";
+        }
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "BenchReport.h"
+
+namespace seneca {
+    namespace {
+        const JsonValue* findBenchmark(const JsonValue* baseline, const std::string& name) {
+            if (!baseline) return nullptr;
+            const JsonValue* benchmarks = baseline->find("benchmarks");
+            if (!benchmarks) return nullptr;
+            for (const auto& benchmark : benchmarks->m_array) {
+                if (benchmark.getString("name", "") == name) return &benchmark;
+            }
+            return nullptr;
+        }
+
+        BenchTolerance toleranceOf(const JsonValue* benchmark) {
+            BenchTolerance tolerance;
+            const JsonValue* limits = benchmark ? benchmark->find("tolerance") : nullptr;
+            if (limits) {
+                tolerance.m_throughput = limits->getNumber("throughput", tolerance.m_throughput);
+                tolerance.m_allocations = limits->getNumber("allocations_per_op", tolerance.m_allocations);
+                tolerance.m_peakRss = limits->getNumber("peak_rss_kb", tolerance.m_peakRss);
+            }
+            return tolerance;
+        }
+
+        // One comparison line; returns true on a regression
+        bool check(std::ostream& os, const std::string& name, const char* metric, double baseline, double current,
+            bool higherIsBetter, double tolerance) {
+            bool regressed = higherIsBetter ? current < baseline * (1.0 - tolerance)
+                                            : current > baseline * (1.0 + tolerance) + 1e-9;
+            double change = baseline != 0 ? (current - baseline) / baseline * 100.0 : 0.0;
+
+            std::ostringstream values;
+            values << std::fixed << std::setprecision(2) << baseline << " -> " << current;
+            os << (regressed ? "REGRESSION  " : "ok          ") << std::left << std::setw(36) << name
+               << std::setw(20) << metric << std::setw(32) << values.str() << std::right << std::showpos
+               << std::fixed << std::setprecision(1) << change << "%" << std::noshowpos
+               << " (limit " << (higherIsBetter ? "-" : "+") << std::setprecision(0) << tolerance * 100 << "%)\n";
+            return regressed;
+        }
+    }
+
+    void writeResultsJson(std::ostream& os, const std::vector<BenchResult>& results, const std::string& buildType,
+        const JsonValue* previous) {
+        os << "{\n  \"build_type\": " << quoteJson(buildType) << ",\n  \"benchmarks\": [";
+        os << std::setprecision(10);
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& result = results[i];
+            BenchTolerance tolerance = toleranceOf(findBenchmark(previous, result.m_name));
+            os << (i == 0 ? "\n" : ",\n")
+               << "    {\"name\": " << quoteJson(result.m_name)
+               << ", \"operations\": " << result.m_operations
+               << ", \"items\": " << result.m_items
+               << ", \"iterations\": " << result.m_iterations
+               << ", \"seconds\": " << result.m_seconds
+               << ", \"throughput\": " << result.getThroughput()
+               << ", \"allocations\": " << result.m_allocations
+               << ", \"allocations_per_op\": " << result.getAllocationsPerOperation()
+               << ", \"bytes\": " << result.m_bytes
+               << ", \"peak_rss_kb\": " << result.m_peakRss;
+            // Hardware events only where the counters could be opened
+            for (size_t event = 0; event < PerfSample::c_events; event++) {
+                if (!getBenchCounters().isAvailable(event)) continue;
+                std::string key = getPerfEventName(event);
+                std::replace(key.begin(), key.end(), '-', '_');
+                os << ", " << quoteJson(key) << ": " << result.m_counters.m_values[event];
+            }
+            os << ",\n     \"tolerance\": {\"throughput\": " << tolerance.m_throughput
+               << ", \"allocations_per_op\": " << tolerance.m_allocations
+               << ", \"peak_rss_kb\": " << tolerance.m_peakRss << "}}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    size_t compareWithBaseline(std::ostream& os, const std::vector<BenchResult>& results, const JsonValue& baseline,
+        const std::string& buildType, const std::string& reference) {
+        std::string baselineBuild = baseline.getString("build_type", "");
+        bool sameBuild = baselineBuild == buildType;
+        if (!sameBuild) {
+            os << "Baseline was recorded with a " << baselineBuild << " build; comparing allocations only\n";
+        }
+
+        std::ios_base::fmtflags flags = os.flags();
+
+        // How much faster this host is than the one that recorded the baseline
+        double hostSpeed = 0;
+        const JsonValue* expectedReference = findBenchmark(&baseline, reference);
+        auto current = std::find_if(results.begin(), results.end(),
+            [&](const BenchResult& result) { return result.m_name == reference; });
+        if (expectedReference && current != results.end() && expectedReference->getNumber("throughput", 0) > 0) {
+            hostSpeed = current->getThroughput() / expectedReference->getNumber("throughput", 0);
+        }
+        bool compareThroughput = sameBuild && hostSpeed > 0;
+        if (compareThroughput) {
+            os << "Host speed against the baseline's: " << std::fixed << std::setprecision(2) << hostSpeed
+               << "x; baseline throughput is scaled by it\n";
+        }
+        else if (sameBuild) {
+            os << "No " << reference << " result on both sides; skipping throughput\n";
+        }
+
+        size_t regressions = 0;
+        for (const auto& result : results) {
+            const JsonValue* expected = findBenchmark(&baseline, result.m_name);
+            if (!expected) {
+                os << "new         " << result.m_name << " (not in the baseline)\n";
+                continue;
+            }
+
+            BenchTolerance tolerance = toleranceOf(expected);
+            if (compareThroughput && result.m_name != reference) {
+                regressions += check(os, result.m_name, "throughput", expected->getNumber("throughput", 0) * hostSpeed,
+                    result.getThroughput(), true, tolerance.m_throughput);
+            }
+            regressions += check(os, result.m_name, "allocations/op", expected->getNumber("allocations_per_op", 0),
+                result.getAllocationsPerOperation(), false, tolerance.m_allocations);
+            double baselineRss = expected->getNumber("peak_rss_kb", 0);
+            if (sameBuild && baselineRss > 0 && result.m_peakRss > 0) {
+                regressions += check(os, result.m_name, "peak RSS (KiB)", baselineRss,
+                    static_cast<double>(result.m_peakRss), false, tolerance.m_peakRss);
+            }
+        }
+        os.flags(flags);
+        return regressions;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef SENECA_BENCHREPORT_H
+#define SENECA_BENCHREPORT_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "Json.h"
+
+namespace seneca {
+    // How far a benchmark may drift from its baseline, as fractions: throughput
+    // may fall by m_throughput, allocations and peak RSS may grow by theirs
+    struct BenchTolerance {
+        double m_throughput{0.5};
+        double m_allocations{0.05};
+        double m_peakRss{0.5};
+    };
+
+    // Writes the results in the baseline format. Tolerances come from the
+    // matching entry of `previous` (an earlier baseline) when there is one.
+    void writeResultsJson(std::ostream& os, const std::vector<BenchResult>& results, const std::string& buildType,
+        const JsonValue* previous = nullptr);
+
+    // Prints every metric next to its baseline and returns how many regressed.
+    // Throughput and peak RSS depend on the build, so they are only compared
+    // when the baseline was recorded with the same build type. Throughput also
+    // depends on the machine: the baseline's figures are scaled by how fast
+    // the `reference` benchmark ran here against its own baseline entry, and
+    // skipped when either side lacks it. Allocation counts are always compared.
+    size_t compareWithBaseline(std::ostream& os, const std::vector<BenchResult>& results, const JsonValue& baseline,
+        const std::string& buildType, const std::string& reference);
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include <iomanip>
+#include "Benchmark.h"
+
+namespace seneca {
+    // Every operator new goes through the tracking allocator
+    // (src/TrackingAllocator.cpp) linked into the bench
+    uint64_t getAllocationCount() {
+        return getMemoryTotals().m_allocations;
+    }
+
+    uint64_t getAllocatedBytes() {
+        return getMemoryTotals().m_bytes;
+    }
+
+    const PerfCounters& getBenchCounters() {
+        static PerfCounters s_counters;
+        return s_counters;
+    }
+
+    double BenchResult::getThroughput() const {
+        return m_seconds > 0 ? m_operations / m_seconds : 0.0;
+    }
+
+    double BenchResult::getAllocationsPerOperation() const {
+        return m_operations > 0 ? static_cast<double>(m_allocations) / m_operations : 0.0;
+    }
+
+    void BenchTimer::start() {
+        m_startAllocations = getAllocationCount();
+        m_startBytes = getAllocatedBytes();
+        m_startCounters = getBenchCounters().read();
+        m_started = std::chrono::steady_clock::now();
+    }
+
+    void BenchTimer::stop() {
+        auto stopped = std::chrono::steady_clock::now();
+        m_counters += getBenchCounters().read() - m_startCounters;
+        m_seconds += std::chrono::duration<double>(stopped - m_started).count();
+        m_allocations += getAllocationCount() - m_startAllocations;
+        m_bytes += getAllocatedBytes() - m_startBytes;
+    }
+
+    double BenchTimer::getSeconds() const {
+        return m_seconds;
+    }
+
+    uint64_t BenchTimer::getAllocations() const {
+        return m_allocations;
+    }
+
+    uint64_t BenchTimer::getBytes() const {
+        return m_bytes;
+    }
+
+    const PerfSample& BenchTimer::getCounters() const {
+        return m_counters;
+    }
+
+    BenchResult runMicro(const std::string& name, MicroBody body, double minSeconds) {
+        bool peakRss = resetPeakRss();
+        // Warm caches and the allocator before measuring
+        BenchTimer warmup;
+        body(16, warmup);
+
+        size_t count = 16;
+        while (true) {
+            BenchTimer timer;
+            body(count, timer);
+            if (timer.getSeconds() >= minSeconds || count >= (size_t(1) << 40)) {
+                BenchResult result;
+                result.m_name = name;
+                result.m_operations = count;
+                result.m_seconds = timer.getSeconds();
+                result.m_allocations = timer.getAllocations();
+                result.m_bytes = timer.getBytes();
+                result.m_peakRss = peakRss ? getPeakRssKilobytes() : 0;
+                result.m_counters = timer.getCounters();
+                return result;
+            }
+            // Aim straight for the target time, but grow at least 2x per round
+            double scale = timer.getSeconds() > 0 ? 1.2 * minSeconds / timer.getSeconds() : 10.0;
+            count = static_cast<size_t>(count * (scale < 2.0 ? 2.0 : (scale > 100.0 ? 100.0 : scale)));
+        }
+    }
+
+    void writeMicroTable(std::ostream& os, const std::vector<BenchResult>& results) {
+        os << std::left << std::setw(34) << "Benchmark" << std::right << std::setw(14) << "Time/op"
+           << std::setw(14) << "Ops/s" << std::setw(12) << "Allocs/op" << std::setw(12) << "Bytes/op" << "\n";
+        os << std::fixed;
+        for (const auto& result : results) {
+            double perOp = result.m_seconds / result.m_operations;
+            os << std::left << std::setw(34) << result.m_name << std::right
+               << std::setw(11) << std::setprecision(1) << perOp * 1e9 << " ns"
+               << std::setw(14) << std::setprecision(0) << result.m_operations / result.m_seconds
+               << std::setw(12) << std::setprecision(2) << static_cast<double>(result.m_allocations) / result.m_operations
+               << std::setw(12) << std::setprecision(1) << static_cast<double>(result.m_bytes) / result.m_operations << "\n";
+        }
+        os.unsetf(std::ios_base::floatfield);
+    }
+
+    void writeMacroTable(std::ostream& os, const std::vector<BenchResult>& results) {
+        os << std::left << std::setw(34) << "Benchmark" << std::right << std::setw(11) << "Time"
+           << std::setw(12) << "Iterations" << std::setw(14) << "Orders/s" << std::setw(14) << "Items/s"
+           << std::setw(14) << "Allocs" << std::setw(13) << "Allocs/order" << "\n";
+        os << std::fixed;
+        for (const auto& result : results) {
+            os << std::left << std::setw(34) << result.m_name << std::right
+               << std::setw(9) << std::setprecision(3) << result.m_seconds << " s"
+               << std::setw(12) << result.m_iterations
+               << std::setw(14) << std::setprecision(0) << result.m_operations / result.m_seconds
+               << std::setw(14) << result.m_items / result.m_seconds
+               << std::setw(14) << result.m_allocations
+               << std::setw(13) << std::setprecision(2) << static_cast<double>(result.m_allocations) / result.m_operations << "\n";
+        }
+        os.unsetf(std::ios_base::floatfield);
+    }
+
+    void writeCounterTable(std::ostream& os, const std::vector<BenchResult>& results) {
+        const PerfCounters& counters = getBenchCounters();
+        if (!counters.isAnyAvailable()) {
+            os << "Hardware counters unavailable (" << counters.getError() << ")\n";
+            return;
+        }
+
+        os << std::left << std::setw(34) << "Benchmark" << std::right;
+        for (size_t i = 0; i < PerfSample::c_events; i++) {
+            os << std::setw(17) << std::string(getPerfEventName(i)) + "/op";
+        }
+        os << std::setw(7) << "IPC" << "\n";
+        os << std::fixed << std::setprecision(2);
+        for (const auto& result : results) {
+            os << std::left << std::setw(34) << result.m_name << std::right;
+            for (size_t i = 0; i < PerfSample::c_events; i++) {
+                if (counters.isAvailable(i)) {
+                    os << std::setw(17) << static_cast<double>(result.m_counters.m_values[i]) / result.m_operations;
+                }
+                else {
+                    os << std::setw(17) << "n/a";
+                }
+            }
+            uint64_t cycles = result.m_counters.m_values[0];
+            if (cycles > 0) {
+                os << std::setw(7) << static_cast<double>(result.m_counters.m_values[1]) / cycles;
+            }
+            else {
+                os << std::setw(7) << "n/a";
+            }
+            os << "\n";
+        }
+        os.unsetf(std::ios_base::floatfield);
+    }
+}
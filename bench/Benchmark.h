@@ -0,0 +1,67 @@
+#ifndef SENECA_BENCHMARK_H
+#define SENECA_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
+
+namespace seneca {
+    // Every operator new in the bench executable
+    uint64_t getAllocationCount();
+    uint64_t getAllocatedBytes();
+    // Hardware counters of the benchmark thread, opened on first use
+    const PerfCounters& getBenchCounters();
+
+    // Accumulates time, allocations and hardware events only between start() and stop(), so a
+    // benchmark can leave its setup out of the measurement
+    class BenchTimer {
+        std::chrono::steady_clock::time_point m_started;
+        uint64_t m_startAllocations{0};
+        uint64_t m_startBytes{0};
+        double m_seconds{0};
+        uint64_t m_allocations{0};
+        uint64_t m_bytes{0};
+        PerfSample m_startCounters;
+        PerfSample m_counters;
+    public:
+        void start();
+        void stop();
+        double getSeconds() const;
+        uint64_t getAllocations() const;
+        uint64_t getBytes() const;
+        const PerfSample& getCounters() const;
+    };
+
+    struct BenchResult {
+        std::string m_name;
+        size_t m_operations{0};     // calls for a micro benchmark, orders for a full run
+        size_t m_items{0};          // order items processed (full runs only)
+        size_t m_iterations{0};     // LineManager iterations (full runs only)
+        double m_seconds{0};
+        uint64_t m_allocations{0};
+        uint64_t m_bytes{0};
+        uint64_t m_peakRss{0};      // KiB, peak while this benchmark ran (0: unknown)
+        PerfSample m_counters;      // hardware events while timed, where available
+        double getThroughput() const;
+        double getAllocationsPerOperation() const;
+    };
+
+    // A micro benchmark body performs `count` operations, timing only the
+    // part between timer.start() and timer.stop()
+    using MicroBody = void (*)(size_t count, BenchTimer& timer);
+
+    // Runs body with a growing count until it has been timed for minSeconds
+    BenchResult runMicro(const std::string& name, MicroBody body, double minSeconds);
+
+    void writeMicroTable(std::ostream& os, const std::vector<BenchResult>& results);
+    void writeMacroTable(std::ostream& os, const std::vector<BenchResult>& results);
+    // Hardware events per operation, or why they are unavailable
+    void writeCounterTable(std::ostream& os, const std::vector<BenchResult>& results);
+}
+
+#endif
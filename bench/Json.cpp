@@ -0,0 +1,178 @@
+#include <cstdlib>
+#include "Json.h"
+
+namespace seneca {
+    namespace {
+        class JsonParser {
+            const std::string& m_text;
+            size_t m_pos{0};
+
+            [[noreturn]] void fail(const std::string& message) const {
+                throw std::string("JSON error at offset ") + std::to_string(m_pos) + ": " + message;
+            }
+
+            void skipSpace() {
+                while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+                    m_pos++;
+                }
+            }
+
+            bool consume(char ch) {
+                skipSpace();
+                if (m_pos < m_text.size() && m_text[m_pos] == ch) {
+                    m_pos++;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char ch) {
+                if (!consume(ch)) fail(std::string("expected '") + ch + "'");
+            }
+
+            bool consumeWord(const char* word) {
+                std::string expected(word);
+                if (m_text.compare(m_pos, expected.size(), expected) != 0) return false;
+                m_pos += expected.size();
+                return true;
+            }
+
+            std::string parseString() {
+                expect('"');
+                std::string value;
+                while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+                    char ch = m_text[m_pos++];
+                    if (ch != '\\') {
+                        value += ch;
+                        continue;
+                    }
+                    if (m_pos >= m_text.size()) break;
+                    char escape = m_text[m_pos++];
+                    switch (escape) {
+                        case 'n': value += '\n'; break;
+                        case 't': value += '\t'; break;
+                        case 'r': value += '\r'; break;
+                        case 'b': value += '\b'; break;
+                        case 'f': value += '\f'; break;
+                        case 'u': {
+                            // Baselines are ASCII; other code points are kept as '?'
+                            if (m_pos + 4 > m_text.size()) fail("bad \\u escape");
+                            long code = std::strtol(m_text.substr(m_pos, 4).c_str(), nullptr, 16);
+                            value += code < 0x80 ? static_cast<char>(code) : '?';
+                            m_pos += 4;
+                            break;
+                        }
+                        default: value += escape; break;
+                    }
+                }
+                if (m_pos >= m_text.size()) fail("unterminated string");
+                m_pos++;
+                return value;
+            }
+
+        public:
+            explicit JsonParser(const std::string& text) : m_text(text) {}
+
+            JsonValue parseValue() {
+                skipSpace();
+                if (m_pos >= m_text.size()) fail("unexpected end");
+
+                JsonValue value;
+                char ch = m_text[m_pos];
+                if (ch == '{') {
+                    value.m_type = JsonValue::Type::Object;
+                    m_pos++;
+                    if (consume('}')) return value;
+                    do {
+                        skipSpace();
+                        std::string key = parseString();
+                        expect(':');
+                        value.m_object.emplace_back(key, parseValue());
+                    } while (consume(','));
+                    expect('}');
+                }
+                else if (ch == '[') {
+                    value.m_type = JsonValue::Type::Array;
+                    m_pos++;
+                    if (consume(']')) return value;
+                    do {
+                        value.m_array.push_back(parseValue());
+                    } while (consume(','));
+                    expect(']');
+                }
+                else if (ch == '"') {
+                    value.m_type = JsonValue::Type::String;
+                    value.m_string = parseString();
+                }
+                else if (consumeWord("true")) {
+                    value.m_type = JsonValue::Type::Bool;
+                    value.m_bool = true;
+                }
+                else if (consumeWord("false")) {
+                    value.m_type = JsonValue::Type::Bool;
+                }
+                else if (consumeWord("null")) {
+                    value.m_type = JsonValue::Type::Null;
+                }
+                else {
+                    const char* start = m_text.c_str() + m_pos;
+                    char* end = nullptr;
+                    value.m_type = JsonValue::Type::Number;
+                    value.m_number = std::strtod(start, &end);
+                    if (end == start) fail("unexpected character");
+                    m_pos += end - start;
+                }
+                return value;
+            }
+
+            void finish() {
+                skipSpace();
+                if (m_pos != m_text.size()) fail("trailing characters");
+            }
+        };
+    }
+
+    const JsonValue* JsonValue::find(const std::string& key) const {
+        for (const auto& member : m_object) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+
+    double JsonValue::getNumber(const std::string& key, double fallback) const {
+        const JsonValue* member = find(key);
+        return member && member->m_type == Type::Number ? member->m_number : fallback;
+    }
+
+    std::string JsonValue::getString(const std::string& key, const std::string& fallback) const {
+        const JsonValue* member = find(key);
+        return member && member->m_type == Type::String ? member->m_string : fallback;
+    }
+
+    JsonValue parseJson(const std::string& text) {
+        JsonParser parser(text);
+        JsonValue value = parser.parseValue();
+        parser.finish();
+        return value;
+    }
+
+    std::string quoteJson(const std::string& text) {
+        static const char hex[] = "0123456789abcdef";
+        std::string quoted = "\"";
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') {
+                quoted += '\\';
+                quoted += ch;
+            }
+            else if (static_cast<unsigned char>(ch) < 0x20) {
+                quoted += "\\u00";
+                quoted += hex[(ch >> 4) & 0xF];
+                quoted += hex[ch & 0xF];
+            }
+            else {
+                quoted += ch;
+            }
+        }
+        return quoted + "\"";
+    }
+}
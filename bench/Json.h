@@ -0,0 +1,31 @@
+#ifndef SENECA_JSON_H
+#define SENECA_JSON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace seneca {
+    // Just enough JSON to read back benchmark baselines
+    struct JsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+        Type m_type{Type::Null};
+        bool m_bool{false};
+        double m_number{0};
+        std::string m_string;
+        std::vector<JsonValue> m_array;
+        std::vector<std::pair<std::string, JsonValue>> m_object;
+
+        // The member called `key`, or nullptr
+        const JsonValue* find(const std::string& key) const;
+        double getNumber(const std::string& key, double fallback) const;
+        std::string getString(const std::string& key, const std::string& fallback) const;
+    };
+
+    // Throws a std::string describing the first syntax error
+    JsonValue parseJson(const std::string& text);
+    // Quoted and escaped for output
+    std::string quoteJson(const std::string& text);
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include <string>
+#include "Utilities.h"
+#include "Workload.h"
+
+namespace seneca {
+    Workload::Workload(const GeneratorSpec& spec) {
+        while (!g_pending.empty()) g_pending.pop_front();
+        while (!g_completed.empty()) g_completed.pop_front();
+        while (!g_incomplete.empty()) g_incomplete.pop_front();
+
+        ScenarioGenerator generator(spec);
+        char originalDelimiter = Utilities::getDelimiter();
+
+        Utilities::setDelimiter(',');
+        for (size_t item : generator.getLineItems()) {
+            m_line.push_back(new Workstation(generator.getStationRecord(item, ',')));
+        }
+
+        Utilities::setDelimiter('|');
+        generator.forEachOrder([&](const std::string& record) {
+            g_pending.push_back(CustomerOrder(record));
+            m_items += g_pending.back().getItemCount();
+        });
+        Utilities::setDelimiter(originalDelimiter);
+    }
+
+    Workload::~Workload() {
+        for (auto* station : m_line) delete station;
+        while (!g_pending.empty()) g_pending.pop_front();
+        while (!g_completed.empty()) g_completed.pop_front();
+        while (!g_incomplete.empty()) g_incomplete.pop_front();
+    }
+
+    const std::vector<Workstation*>& Workload::getLine() const {
+        return m_line;
+    }
+
+    size_t Workload::getItemCount() const {
+        return m_items;
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef SENECA_WORKLOAD_H
+#define SENECA_WORKLOAD_H
+
+#include <cstddef>
+#include <vector>
+#include "ScenarioGenerator.h"
+#include "Workstation.h"
+
+namespace seneca {
+    // A generated scenario held in memory: the line's stations in order, and
+    // the orders waiting in this thread's g_pending. Stations and orders are
+    // parsed from the generated records, as batch mode would.
+    class Workload {
+        std::vector<Workstation*> m_line;
+        size_t m_items{0};
+    public:
+        explicit Workload(const GeneratorSpec& spec);
+        ~Workload();
+        Workload(const Workload&) = delete;
+        Workload& operator=(const Workload&) = delete;
+        const std::vector<Workstation*>& getLine() const;
+        size_t getItemCount() const;
+    };
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SENECA_ASYNCLOGGER_H
+#define SENECA_ASYNCLOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OutputBuffer.h"
+#include "SimulationObserver.h"
+
+namespace seneca {
+	// Produces the same iteration and fill log LineManager::run writes, but
+	// off the simulating thread. Each callback copies a small record into a
+	// lock-free single-producer ring; a writer thread formats the records and
+	// writes them in large blocks. Use one logger per simulating thread, run
+	// the line against a stream that discards its output, and close() the
+	// logger before writing anything else to the same stream.
+	class AsyncLogger : public SimulationObserver {
+		std::vector<char> m_ring;
+		size_t m_mask{0};
+		std::atomic<size_t> m_head{0};	// bytes published by the simulating thread
+		std::atomic<size_t> m_tail{0};	// bytes consumed by the writer thread
+		std::atomic<bool> m_closing{false};
+		size_t m_reserved{0};
+		OutputBuffer m_output;
+		std::thread m_writer;
+		void reserve(size_t size);
+		void put(const void* data, size_t size);
+		void putString(const std::string& text);
+		void publish();
+		void get(size_t& position, void* data, size_t size) const;
+		void writeString(size_t& position);
+		size_t drain();
+		void writerLoop();
+	public:
+		explicit AsyncLogger(std::ostream& os, size_t capacity = 1 << 20);
+		~AsyncLogger();
+		AsyncLogger(const AsyncLogger&) = delete;
+		AsyncLogger& operator=(const AsyncLogger&) = delete;
+		void onIteration(size_t iteration) override;
+		void onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) override;
+		// Writes out every record logged so far and stops the writer thread
+		void close();
+	};
+}
+
+#endif
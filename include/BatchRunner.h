@@ -0,0 +1,77 @@
+#ifndef SENECA_BATCHRUNNER_H
+#define SENECA_BATCHRUNNER_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Scenario.h"
+#include "SimulationContext.h"
+
+namespace seneca {
+	struct BatchInputFile {
+		std::string m_file;
+		char m_delimiter;
+	};
+
+	// One scenario of a manifest and how to run it
+	struct BatchJob {
+		std::string m_name;						// also names the result file
+		std::vector<BatchInputFile> m_stations;
+		BatchInputFile m_orders{"", '|'};
+		std::string m_line;
+		std::string m_engine{"fast-forward"};	// "fast-forward", "tick" or an --engine policy list
+		InventoryOverlay m_stock;
+		std::string m_report;					// "csv" or "jsonl" adds <name>.csv or <name>.jsonl
+	};
+
+	struct BatchOutcome {
+		std::string m_name;
+		std::string m_error;		// empty when the scenario ran
+		SimulationResult m_result;
+	};
+
+	// Runs many scenarios, described by a manifest, across a pool of workers.
+	// A file named by several scenarios is parsed once, and scenarios with the
+	// same inputs share one Scenario; every run still gets its own context.
+	//
+	// The manifest is a list of sections; paths are relative to the manifest:
+	//
+	//	# comment
+	//	[office-4-desks]
+	//	stations = Stations1.txt ,
+	//	stations = Stations2.txt |
+	//	orders = CustomerOrders.txt
+	//	line = AssemblyLine.txt
+	//	engine = tick
+	//	stock = Desk=4
+	//	report = csv
+	//
+	// `stations` repeats once per file and ends with the file's delimiter
+	// (',' when omitted); `orders` may end with one too ('|' when omitted).
+	class BatchRunner {
+		std::vector<BatchJob> m_jobs;
+		size_t m_workers;
+		std::map<std::string, std::shared_ptr<const Scenario>> m_stationFiles;
+		std::map<std::string, std::shared_ptr<const Scenario>> m_orderFiles;
+		std::map<std::string, std::shared_ptr<const Scenario>> m_scenarios;
+		size_t m_filesParsed{0};
+		std::shared_ptr<const Scenario> prepare(const BatchJob& job);
+	public:
+		explicit BatchRunner(size_t workers = 0);
+		void addJob(const BatchJob& job);
+		void loadManifest(const std::string& file);
+		const std::vector<BatchJob>& getJobs() const;
+		// Writes <directory>/<name>.txt per scenario and <directory>/summary.txt.
+		// A scenario that fails is reported in its outcome and the summary;
+		// the others still run.
+		std::vector<BatchOutcome> run(const std::string& directory);
+		size_t getFilesParsed() const;
+		size_t getScenariosBuilt() const;
+		static void writeSummary(std::ostream& os, const std::vector<BatchOutcome>& outcomes);
+	};
+}
+
+#endif
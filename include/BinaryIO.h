@@ -0,0 +1,24 @@
+#ifndef SENECA_BINARYIO_H
+#define SENECA_BINARYIO_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace seneca {
+	// Fixed-width little-endian encoding, so files written by one process or
+	// host read back identically in another
+	void writeBinary(std::ostream& os, uint64_t value);
+	void writeBinary(std::ostream& os, const std::string& value);
+	uint64_t readBinary(std::istream& is);
+	std::string readBinaryString(std::istream& is);
+
+	// Variable-length encoding (7 bits per byte) for compact streams of small numbers
+	void writeVarint(std::ostream& os, uint64_t value);
+	void writeVarintString(std::ostream& os, const std::string& value);
+	uint64_t readVarint(std::istream& is);
+	std::string readVarintString(std::istream& is);
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SENECA_CHECKPOINT_H
+#define SENECA_CHECKPOINT_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "LineManager.h"
+#include "Workstation.h"
+
+namespace seneca {
+	// A checkpoint holds everything a run changes: every station's stock and
+	// order queue, the pending/completed/incomplete queues, the iteration
+	// counter and the display field widths. Restoring it into a LineManager
+	// built from the same station and line files continues the run exactly
+	// where it stopped. `stations` must list the stations in load order.
+	void saveCheckpoint(std::ostream& os, const LineManager& manager, const std::vector<Workstation*>& stations);
+	void restoreCheckpoint(std::istream& is, LineManager& manager, const std::vector<Workstation*>& stations);
+
+	// File variants; saving writes a temporary file and renames it over the
+	// target, so a crash mid-write never destroys the previous checkpoint
+	void saveCheckpoint(const std::string& file, const LineManager& manager, const std::vector<Workstation*>& stations);
+	void restoreCheckpoint(const std::string& file, LineManager& manager, const std::vector<Workstation*>& stations);
+}
+
+#endif
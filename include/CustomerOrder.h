@@ -1,10 +1,14 @@
 #ifndef SENECA_CUSTOMERORDER_H
 #define SENECA_CUSTOMERORDER_H
 
+#include <istream>
+#include <ostream>
 #include <string>
 #include "Station.h"
 
 namespace seneca {
+	class OutputBuffer;
+	class SimulationObserver;
 
 	class CustomerOrder {
 		struct Item {
@@ -18,6 +22,7 @@ namespace seneca {
 		std::string m_product;
 		size_t m_cntItem;
 		Item** m_lstItem;
+		size_t m_id{0};
 		static size_t m_widthField;
 	public:
 		CustomerOrder();
@@ -29,8 +34,26 @@ namespace seneca {
 		~CustomerOrder();
 		bool isOrderFilled() const;
 		bool isItemFilled(const std::string& itemName) const;
-		void fillItem(Station& station, std::ostream& os);
+		void fillItem(Station& station, std::ostream& os, SimulationObserver* observer = nullptr);
+		bool fillItemAt(size_t index, Station& station);
+		void fillItemAt(size_t index, size_t serialNumber);
 		void display(std::ostream& os) const;
+		void display(OutputBuffer& output) const;
+		// With the item column `width` wide instead of the shared width
+		void display(OutputBuffer& output, size_t width) const;
+		CustomerOrder clone() const;
+		const std::string& getName() const;
+		const std::string& getProduct() const;
+		size_t getItemCount() const;
+		const std::string& getItemName(size_t index) const;
+		size_t getItemSerialNumber(size_t index) const;
+		bool isItemFilledAt(size_t index) const;
+		size_t getId() const;
+		void setId(size_t id);
+		void saveState(std::ostream& os) const;
+		void loadState(std::istream& is);
+		static size_t getWidthField();
+		static void setWidthField(size_t width);
 	};
 }
 
@@ -0,0 +1,123 @@
+#ifndef SENECA_EVENTLOG_H
+#define SENECA_EVENTLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LineManager.h"
+#include "OutputBuffer.h"
+#include "SimulationObserver.h"
+
+namespace seneca {
+	enum class EventType : uint8_t {
+		Admit = 1,
+		Fill,
+		UnableToFill,
+		Move,
+		Complete,
+		Incomplete
+	};
+
+	struct LoggedEvent {
+		EventType m_type{EventType::Admit};
+		size_t m_iteration{0};
+		size_t m_station{0};	// index into the log's station table
+		size_t m_target{0};		// destination station of a Move
+		size_t m_order{0};		// CustomerOrder id
+		size_t m_item{0};		// item index within the order (Fill, UnableToFill)
+		size_t m_serial{0};		// serial number given out by a Fill
+	};
+	bool operator==(const LoggedEvent& lhs, const LoggedEvent& rhs);
+	bool operator!=(const LoggedEvent& lhs, const LoggedEvent& rhs);
+
+	struct LoggedStation {
+		std::string m_name;
+		size_t m_serialNumber{0};
+		size_t m_quantity{0};
+	};
+
+	struct LoggedItem {
+		std::string m_name;
+		size_t m_serialNumber{0};
+		bool m_isFilled{false};
+	};
+
+	struct LoggedOrder {
+		size_t m_id{0};
+		std::string m_name;
+		std::string m_product;
+		std::vector<LoggedItem> m_items;
+	};
+
+	// Writes a compact binary log of a run: a header with the line's stations
+	// and the pending orders, then one record per event. Attach it with
+	// LineManager::setObserver before the first iteration.
+	class EventRecorder : public SimulationObserver {
+		std::ostream& m_os;
+		std::unordered_map<const Station*, size_t> m_stationIndex;
+		size_t m_iteration{0};
+		size_t m_lastIteration{0};
+		void write(EventType type, size_t station, size_t order, size_t extra1 = 0, size_t extra2 = 0);
+		size_t indexOf(const Station& station) const;
+	public:
+		EventRecorder(std::ostream& os, const LineManager& manager);
+		void onIteration(size_t iteration) override;
+		void onAdmit(const Workstation& station, const CustomerOrder& order) override;
+		void onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) override;
+		void onMove(const Workstation& from, const Workstation& to, const CustomerOrder& order) override;
+		void onFinish(const Workstation& station, const CustomerOrder& order, bool completed) override;
+	};
+
+	// Reads a log written by EventRecorder, one event at a time
+	class EventLogReader {
+		std::istream& m_is;
+		std::vector<LoggedStation> m_stations;
+		std::vector<LoggedOrder> m_orders;
+		size_t m_orderWidth{0};
+		size_t m_iteration{0};
+	public:
+		EventLogReader(std::istream& is);
+		const std::vector<LoggedStation>& getStations() const;
+		// CustomerOrder::getWidthField() when the run was recorded
+		size_t getOrderWidth() const;
+		const std::vector<LoggedOrder>& getOrders() const;
+		bool next(LoggedEvent& event);
+		std::string describe(const LoggedEvent& event) const;
+	};
+
+	// The state of a recorded run rebuilt purely from its events
+	class ReplayState {
+		size_t m_iteration{0};
+		size_t m_firstId{0};
+		std::vector<LoggedStation> m_stations;
+		std::vector<std::deque<size_t>> m_queues;
+		std::vector<LoggedOrder> m_orders;
+		size_t m_orderWidth{0};
+		std::deque<size_t> m_pending;
+		std::deque<size_t> m_completed;
+		std::deque<size_t> m_incomplete;
+		size_t slot(size_t id) const;
+		void displayOrders(OutputBuffer& output, const std::deque<size_t>& ids) const;
+	public:
+		ReplayState(const EventLogReader& reader);
+		void apply(const LoggedEvent& event);
+		size_t getIteration() const;
+		const std::vector<LoggedStation>& getStations() const;
+		const std::deque<size_t>& getQueue(size_t station) const;
+		const std::deque<size_t>& getPending() const;
+		const std::deque<size_t>& getCompleted() const;
+		const std::deque<size_t>& getIncomplete() const;
+		const LoggedOrder& getOrder(size_t id) const;
+		void display(std::ostream& os) const;
+		// State after `iteration` (the final state by default)
+		static ReplayState replay(std::istream& is, size_t iteration = std::numeric_limits<size_t>::max());
+	};
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef SENECA_FACTORYCORE_H
+#define SENECA_FACTORYCORE_H
+
+// Public entry point of the factory_core library. A service that embeds the
+// engine loads a Scenario once, then builds a SimulationContext from it for
+// every run; contexts are independent, so runs may go on in parallel:
+//
+//     seneca::Scenario scenario = seneca::loadScenario(s1, s2, orders, line);
+//     seneca::SimulationContext context(scenario, overlay);
+//     seneca::SimulationResult result = context.fastForward();
+//     for (const auto& order : context.getCompleted()) ...
+//
+// Scenario, SimulationContext, SimulationResult, InventoryOverlay,
+// LineOptimizer and InventorySweep make up the stable API. The other headers
+// are installed for the tools and may change between minor versions.
+
+#include <string>
+#include "InventorySweep.h"
+#include "LineOptimizer.h"
+#include "Scenario.h"
+#include "SimulationContext.h"
+
+namespace seneca {
+	// "major.minor.patch" of the library the program is linked against
+	const char* getFactoryCoreVersion();
+
+	// Loads the four batch-mode files: comma-delimited stations, pipe-delimited
+	// stations, pipe-delimited orders and the assembly line
+	Scenario loadScenario(const std::string& stations1, const std::string& stations2,
+		const std::string& orders, const std::string& line);
+}
+
+#endif
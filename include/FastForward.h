@@ -0,0 +1,30 @@
+#ifndef SENECA_FASTFORWARD_H
+#define SENECA_FASTFORWARD_H
+
+#include <cstddef>
+#include <vector>
+#include "Workstation.h"
+
+namespace seneca {
+	// Produces the outcome of running LineManager::run to completion over the
+	// given line, without ticking: every order in g_pending is admitted, filled
+	// and moved to g_completed or g_incomplete with the same serial numbers,
+	// the stations end with the same stock, and the return value is the number
+	// of iterations the tick engine would have taken.
+	//
+	// This works because orders never overtake each other: each station serves
+	// them in admission order and hands out its stock greedily, so allocation is
+	// one pass over the order items, and each order's departure from a station
+	// follows from its arrival, its fill count and the previous order's departure.
+	// An order only touches the stations it fills from and the runs between them
+	// where it waits behind the order before it. On lines much longer than the
+	// orders, those runs are kept as steps, and the cost is O(log stations) per
+	// item. Otherwise a flat pass over the line per order is faster.
+	//
+	// `line` must be the stations in travel order (LineManager::getActiveLine
+	// after reorderStations), and the stations' own queues must be empty.
+	// With a sink, finished orders go to it instead of the global queues.
+	size_t fastForward(const std::vector<Workstation*>& line, ResultSink* sink = nullptr);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SENECA_INVENTORYSWEEP_H
+#define SENECA_INVENTORYSWEEP_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Scenario.h"
+#include "SimulationContext.h"
+
+namespace seneca {
+	// The quantities to try for one station
+	struct SweepAxis {
+		std::string m_station;
+		std::vector<size_t> m_quantities;
+	};
+
+	struct SweepPoint {
+		std::vector<size_t> m_quantities;	// one per axis, in axis order
+		SimulationResult m_result;
+	};
+
+	// Runs a Scenario at every combination of the axes' station quantities.
+	// All points share the one parsed Scenario; each point only carries the
+	// quantities it overrides, and points are simulated in parallel with the
+	// fast-forward engine unless told to tick.
+	class InventorySweep {
+		const Scenario& m_scenario;
+		std::vector<SweepAxis> m_axes;
+		size_t m_workers;
+		bool m_fastForward{true};
+	public:
+		InventorySweep(const Scenario& scenario, size_t workers = 0);
+		void setFastForward(bool fastForward);
+		void addAxis(const SweepAxis& axis);
+		size_t getPointCount() const;
+		InventoryOverlay getOverlay(size_t point) const;
+		std::vector<SweepPoint> run() const;
+		void writeTable(std::ostream& os, const std::vector<SweepPoint>& points) const;
+		static SweepAxis parseAxis(const std::string& spec);
+	};
+}
+
+#endif
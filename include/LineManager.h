@@ -2,6 +2,8 @@
 #define SENECA_LINEMANAGER_H
 
 #include <vector>
+#include "ResultSink.h"
+#include "SimulationObserver.h"
 #include "Workstation.h"
 
 namespace seneca {
@@ -9,11 +11,22 @@ namespace seneca {
 		std::vector<Workstation*> m_activeLine;		
 		size_t m_cntCustomerOrder;
 		Workstation* m_firstStation;
+		size_t m_iteration{0};
+		SimulationObserver* m_observer{nullptr};
+		ResultSink* m_sink{nullptr};
 	public:
 		LineManager(const std::string& file, const std::vector<Workstation*>& stations);	
+		LineManager(const std::vector<Workstation*>& line);
 		void reorderStations();
 		bool run(std::ostream& os);
 		void display(std::ostream& os) const;
+		const std::vector<Workstation*>& getActiveLine() const;
+		size_t getIterationCount() const;
+		size_t getOrderCount() const;
+		void setObserver(SimulationObserver* observer);
+		void setResultSink(ResultSink* sink);
+		void saveState(std::ostream& os) const;
+		void loadState(std::istream& is);
 	};
 }
 
@@ -0,0 +1,47 @@
+#ifndef SENECA_LINEOPTIMIZER_H
+#define SENECA_LINEOPTIMIZER_H
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Scenario.h"
+
+namespace seneca {
+	struct LineFitness {
+		size_t m_completed{0};
+		size_t m_iterations{0};
+	};
+
+	struct OptimizerOptions {
+		size_t m_workers{0};		// 0 uses every hardware thread
+		size_t m_restarts{0};		// extra searches from shuffled lines
+		size_t m_maxRounds{1000};	// improvement steps per search
+		unsigned m_seed{1};
+		bool m_fastForward{true};	// false ticks every candidate through LineManager::run
+	};
+
+	// Searches station orderings of a Scenario's line for the one that completes
+	// the most orders in the fewest iterations. Uses steepest-ascent local search
+	// over pairwise swaps; each round's neighbours are simulated in parallel and
+	// every ordering is simulated at most once.
+	class LineOptimizer {
+		const Scenario& m_scenario;
+		OptimizerOptions m_options;
+		std::map<std::string, LineFitness> m_memo;
+
+		static std::string makeKey(const std::vector<std::string>& line);
+		void evaluate(const std::vector<std::vector<std::string>>& candidates);
+		std::vector<std::string> search(std::vector<std::string> line);
+	public:
+		LineOptimizer(const Scenario& scenario, const OptimizerOptions& options = OptimizerOptions());
+		std::vector<std::string> optimize();
+		LineFitness getFitness(const std::vector<std::string>& line);
+		size_t getEvaluationCount() const;
+		static bool isBetter(const LineFitness& lhs, const LineFitness& rhs);
+		static void writeLine(std::ostream& os, const std::vector<std::string>& line);
+	};
+}
+
+#endif
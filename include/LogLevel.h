@@ -0,0 +1,41 @@
+#ifndef SENECA_LOGLEVEL_H
+#define SENECA_LOGLEVEL_H
+
+#include <string>
+
+// Highest level compiled in (see LOG_MAX_LEVEL in CMakeLists.txt)
+#ifndef SENECA_LOG_MAX_LEVEL
+#define SENECA_LOG_MAX_LEVEL 3
+#endif
+
+namespace seneca {
+	// Each level includes everything below it
+	enum class LogLevel {
+		Off = 0,
+		Summary,	// final report of completed and incomplete orders
+		Iteration,	// "Line Manager Iteration" lines
+		Fill		// "Filled" / "Unable to fill" lines
+	};
+
+	constexpr LogLevel maxLogLevel = static_cast<LogLevel>(SENECA_LOG_MAX_LEVEL);
+
+	// The run-time level, shared by every thread; Fill by default
+	LogLevel getLogLevel();
+	void setLogLevel(LogLevel level);
+	// "off", "summary", "iteration" or "fill"
+	LogLevel parseLogLevel(const std::string& name);
+
+	// Messages above maxLogLevel compile away entirely, formatting included
+	template <LogLevel level>
+	inline bool isLogEnabled() {
+		static_assert(level != LogLevel::Off, "Off is not a message level");
+		if constexpr (level > maxLogLevel) {
+			return false;
+		}
+		else {
+			return level <= getLogLevel();
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SENECA_MEMORYTRACKER_H
+#define SENECA_MEMORYTRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace seneca {
+	// What a run was doing when memory was allocated; set by the program
+	enum class MemoryPhase {
+		Startup = 0,
+		Load,
+		Configure,
+		Simulate,
+		Report
+	};
+
+	// Which part of the model allocated; set around the code that allocates
+	enum class MemoryTag {
+		Other = 0,
+		StationStrings,		// Station names and descriptions
+		OrderItems,			// CustomerOrder names, item arrays and items
+		DequeChunks,		// order queues: pending, station, completed, incomplete
+		LogFormatting		// the async log ring and its writer
+	};
+
+	const size_t c_memoryPhases = 5;
+	const size_t c_memoryTags = 5;
+	const char* getMemoryPhaseName(MemoryPhase phase);
+	const char* getMemoryTagName(MemoryTag tag);
+
+	struct MemoryStats {
+		uint64_t m_allocations{0};
+		uint64_t m_bytes{0};		// requested, excluding the tracker's header
+		uint64_t m_live{0};			// bytes not yet freed
+		uint64_t m_peakLive{0};
+	};
+
+	// Applies to every thread: the log writer's allocations count
+	// toward the phase the main thread is in
+	void setMemoryPhase(MemoryPhase phase);
+	MemoryPhase getMemoryPhase();
+	// The calling thread's current tag
+	MemoryTag getMemoryTag();
+	void setMemoryTag(MemoryTag tag);
+
+	// Called by the tracking allocator (TrackingAllocator.cpp); returns the
+	// cell to pass back when the block is freed
+	uint32_t trackAllocation(size_t size);
+	void trackDeallocation(uint32_t cell, size_t size);
+
+	// Allocations made since startup under one phase and tag; memory freed
+	// later still comes off the live count of the cell that allocated it
+	MemoryStats getMemoryStats(MemoryPhase phase, MemoryTag tag);
+	MemoryStats getMemoryTotals();
+	// Highest total live memory seen while the phase was current
+	uint64_t getMemoryPhasePeak(MemoryPhase phase);
+	// Peak resident set size of the process so far, or 0 where unknown
+	uint64_t getPeakRssKilobytes();
+	// Restarts the peak RSS from the current resident size, so it covers
+	// only what runs next; false where the mark cannot be reset (Linux only)
+	bool resetPeakRss();
+	// Totals, then every phase and component that allocated, with peak RSS.
+	// Without the tracking allocator linked in, everything reads as zero.
+	void writeMemoryReport(std::ostream& os);
+	// Writes the report to std::cerr when the program exits
+	void writeMemoryReportAtExit();
+
+	// Tags the calling thread's allocations until the end of the scope
+	class MemoryTagScope {
+		MemoryTag m_previous;
+	public:
+		explicit MemoryTagScope(MemoryTag tag) : m_previous(getMemoryTag()) {
+			setMemoryTag(tag);
+		}
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+		~MemoryTagScope() {
+			setMemoryTag(m_previous);
+		}
+	};
+}
+
+// Attribution points. Without SENECA_MEMORY_TRACKING (the MEMORY_TRACKING
+// option in CMakeLists.txt) they expand to nothing.
+#ifdef SENECA_MEMORY_TRACKING
+#define SENECA_MEMORY_TAG(tag) seneca::MemoryTagScope seneca_memory_tag(seneca::MemoryTag::tag)
+#define SENECA_MEMORY_PHASE(phase) seneca::setMemoryPhase(seneca::MemoryPhase::phase)
+#define SENECA_MEMORY_REPORT_AT_EXIT() seneca::writeMemoryReportAtExit()
+#else
+#define SENECA_MEMORY_TAG(tag) static_cast<void>(0)
+#define SENECA_MEMORY_PHASE(phase) static_cast<void>(0)
+#define SENECA_MEMORY_REPORT_AT_EXIT() static_cast<void>(0)
+#endif
+
+#endif
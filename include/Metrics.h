@@ -0,0 +1,113 @@
+#ifndef SENECA_METRICS_H
+#define SENECA_METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LineManager.h"
+#include "SimulationObserver.h"
+
+namespace seneca {
+	class OutputBuffer;
+
+	// Counts values in power-of-two buckets: bucket 0 holds 0, bucket k holds
+	// [2^(k-1), 2^k). Recording is a handful of relaxed atomic increments,
+	// so other threads may read while a run is recording.
+	class LogHistogram {
+	public:
+		static const size_t c_buckets = 65;
+	private:
+		std::atomic<uint64_t> m_buckets[c_buckets]{};
+		std::atomic<uint64_t> m_count{0};
+		std::atomic<uint64_t> m_sum{0};
+		std::atomic<uint64_t> m_max{0};
+	public:
+		void record(uint64_t value);
+		uint64_t getCount() const;
+		uint64_t getMax() const;
+		double getMean() const;
+		uint64_t getBucket(size_t bucket) const;
+		// Upper bound of the bucket holding the p-th fraction of the values
+		uint64_t getPercentile(double p) const;
+		static size_t bucketOf(uint64_t value);
+		static uint64_t bucketLow(size_t bucket);
+		static uint64_t bucketHigh(size_t bucket);
+		// "[1,2) 4  [2,4) 1 ..." for every non-empty bucket
+		void display(std::ostream& os) const;
+		void display(OutputBuffer& output) const;
+	};
+
+	// A queue length over a run, as the peak of each window of iterations,
+	// oldest first. There are at most c_points windows: when a run outgrows
+	// them, neighbouring windows merge and the window doubles, so memory
+	// stays fixed however long the run. One thread records; others may read.
+	class QueueSeries {
+	public:
+		static const size_t c_points = 32;
+	private:
+		std::atomic<uint64_t> m_peaks[c_points]{};
+		std::atomic<uint64_t> m_window{1};		// iterations per point
+		std::atomic<uint64_t> m_recorded{0};	// iterations recorded
+	public:
+		void record(uint64_t length);
+		uint64_t getWindow() const;
+		size_t getPointCount() const;
+		uint64_t getPoint(size_t point) const;
+		// "0 1 3 5 4 2 0", one peak per window
+		void display(std::ostream& os) const;
+		void display(OutputBuffer& output) const;
+	};
+
+	// What one station did over a run. Each iteration counts as exactly one
+	// of busy (filled at least one item), starved (had an order needing its
+	// item but no stock) or idle (nothing to fill).
+	struct StationMetrics {
+		std::string m_name;
+		std::atomic<uint64_t> m_busy{0};
+		std::atomic<uint64_t> m_idle{0};
+		std::atomic<uint64_t> m_starved{0};
+		std::atomic<uint64_t> m_fills{0};
+		std::atomic<uint64_t> m_stockOuts{0};
+		std::atomic<uint64_t> m_queueSum{0};	// queue length summed over iterations
+		std::atomic<uint64_t> m_queueMax{0};
+		QueueSeries m_queue;					// queue length over time
+		LogHistogram m_wait;					// fill phases each order spent here (0: passed straight through)
+	};
+
+	// Collects StationMetrics for every station of a line, plus the
+	// end-to-end latency of every order, from the run's observer callbacks.
+	// Attach it with LineManager::setObserver before the first iteration.
+	class MetricsCollector : public SimulationObserver {
+		std::unordered_map<const Station*, size_t> m_stationIndex;
+		std::vector<StationMetrics> m_stations;
+		std::vector<size_t> m_queueLength;		// orders present during this iteration's fills
+		std::vector<bool> m_filled;
+		std::vector<bool> m_stockOut;
+		std::unordered_map<size_t, size_t> m_arrived;	// order id -> iteration it reached its station
+		std::unordered_map<size_t, size_t> m_admitted;	// order id -> admission iteration
+		std::vector<const Workstation*> m_line;
+		size_t m_iteration{0};
+		std::atomic<uint64_t> m_iterations{0};
+		LogHistogram m_latency;
+		size_t indexOf(const Station& station) const;
+		void depart(size_t station, const CustomerOrder& order);
+	public:
+		explicit MetricsCollector(const LineManager& manager);
+		void onIteration(size_t iteration) override;
+		void onAdmit(const Workstation& station, const CustomerOrder& order) override;
+		void onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) override;
+		void onMove(const Workstation& from, const Workstation& to, const CustomerOrder& order) override;
+		void onFinish(const Workstation& station, const CustomerOrder& order, bool completed) override;
+		void onIterationEnd(size_t iteration) override;
+		const std::vector<StationMetrics>& getStations() const;
+		const LogHistogram& getLatency() const;
+		uint64_t getIterationCount() const;
+		void report(std::ostream& os) const;
+	};
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SENECA_OUTPUTBUFFER_H
+#define SENECA_OUTPUTBUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace seneca {
+	// Collects text in memory and hands it to the stream in large blocks, so
+	// a long run costs a few big writes instead of one per line. The padding
+	// helpers stand in for setw/setfill: text longer than the width is never cut.
+	class OutputBuffer {
+		std::ostream& m_os;
+		std::vector<char> m_buffer;
+		size_t m_size{0};
+		OutputBuffer& writeThrough(const char* data, size_t size);
+	public:
+		explicit OutputBuffer(std::ostream& os, size_t capacity = 64 * 1024);
+		~OutputBuffer();
+		OutputBuffer(const OutputBuffer&) = delete;
+		OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+		// Inline while the text fits, since report writers call these per field
+		OutputBuffer& write(const char* data, size_t size) {
+			if (m_size + size > m_buffer.size()) return writeThrough(data, size);
+			std::memcpy(m_buffer.data() + m_size, data, size);
+			m_size += size;
+			return *this;
+		}
+		OutputBuffer& operator<<(const std::string& text) {
+			return write(text.data(), text.size());
+		}
+		OutputBuffer& operator<<(const char* text) {
+			return write(text, std::strlen(text));
+		}
+		OutputBuffer& operator<<(char ch) {
+			if (m_size == m_buffer.size()) return writeThrough(&ch, 1);
+			m_buffer[m_size++] = ch;
+			return *this;
+		}
+		OutputBuffer& operator<<(size_t value);
+		OutputBuffer& pad(size_t count, char fill = ' ');
+		// As setw(width) << setfill(fill) << std::right
+		OutputBuffer& writeRight(size_t value, size_t width, char fill = ' ');
+		// As setw(width) << setfill(' ') << std::left
+		OutputBuffer& writeLeft(const std::string& text, size_t width);
+		// As setw(width) << setfill(' ') << std::right
+		OutputBuffer& writeRight(const std::string& text, size_t width);
+		// As setw(width) << std::fixed << setprecision(decimals) << std::right
+		OutputBuffer& writeFixed(double value, int decimals, size_t width = 0);
+		// Writes everything buffered so far and flushes the stream
+		void flush();
+		size_t getPending() const;
+	};
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SENECA_PARALLEL_H
+#define SENECA_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seneca {
+	// Number of worker threads to use when the caller asks for "all of them" (0)
+	inline size_t resolveWorkerCount(size_t workers) {
+		if (workers == 0) workers = std::thread::hardware_concurrency();
+		return workers == 0 ? 1 : workers;
+	}
+
+	// Calls fn(i) for every i in [0, count) across up to `workers` threads.
+	// The first exception thrown by any call is rethrown on the calling thread.
+	template <typename Function>
+	void parallelFor(size_t count, size_t workers, Function fn) {
+		workers = std::min(resolveWorkerCount(workers), count);
+		if (workers <= 1) {
+			for (size_t i = 0; i < count; i++) fn(i);
+			return;
+		}
+
+		std::atomic<size_t> next{0};
+		std::exception_ptr error;
+		std::mutex errorLock;
+		std::vector<std::thread> threads;
+
+		for (size_t w = 0; w < workers; w++) {
+			threads.emplace_back([&]() {
+				for (size_t i = next++; i < count; i = next++) {
+					try {
+						fn(i);
+					} catch (...) {
+						std::lock_guard<std::mutex> lock(errorLock);
+						if (!error) error = std::current_exception();
+						next = count;
+					}
+				}
+			});
+		}
+
+		for (auto& thread : threads) thread.join();
+		if (error) std::rethrow_exception(error);
+	}
+}
+
+#endif
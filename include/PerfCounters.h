@@ -0,0 +1,63 @@
+#ifndef SENECA_PERFCOUNTERS_H
+#define SENECA_PERFCOUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace seneca {
+	// Counts of the hardware events PerfCounters reads, indexed by event
+	struct PerfSample {
+		static const size_t c_events = 4;	// cycles, instructions, cache misses, branch misses
+		uint64_t m_values[c_events]{};
+		PerfSample& operator+=(const PerfSample& other);
+		PerfSample operator-(const PerfSample& other) const;
+	};
+
+	// "cycles", "instructions", "cache-misses" or "branch-misses"
+	const char* getPerfEventName(size_t event);
+
+	// Hardware counters of the calling thread and every thread it starts
+	// afterwards, read through perf_event_open. Open them before starting
+	// worker threads, such as the AsyncLogger's writer, to include them.
+	// An event that cannot be opened (not Linux, no PMU under a VM,
+	// perf_event_paranoid too strict) stays unavailable and reads as 0, and
+	// the reason is kept for the report.
+	class PerfCounters {
+		int m_fd[PerfSample::c_events];
+		std::string m_error;
+	public:
+		PerfCounters();
+		PerfCounters(const PerfCounters&) = delete;
+		PerfCounters& operator=(const PerfCounters&) = delete;
+		~PerfCounters();
+		bool isAvailable(size_t event) const;
+		bool isAnyAvailable() const;
+		// Why the unavailable events could not be opened; empty if all were
+		const std::string& getError() const;
+		// Counts since the counters were opened, scaled up if the kernel multiplexed them
+		PerfSample read() const;
+	};
+
+	// Splits a run into consecutive named phases. Each end() charges the
+	// events since the previous end() (or construction) to a phase.
+	class PerfPhases {
+		PerfCounters m_counters;
+		PerfSample m_mark;
+		std::vector<std::pair<std::string, PerfSample>> m_phases;
+	public:
+		PerfPhases();
+		// Starts the next phase here, dropping the events since the last end()
+		void begin();
+		void end(const std::string& phase);
+		const PerfCounters& getCounters() const;
+		const std::vector<std::pair<std::string, PerfSample>>& getPhases() const;
+		// Counts per phase with IPC, or the reason the counters are unavailable
+		void report(std::ostream& os) const;
+	};
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef SENECA_POLICYENGINE_H
+#define SENECA_POLICYENGINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "CustomerOrder.h"
+#include "Scenario.h"
+#include "SimulationContext.h"
+#include "Station.h"
+
+namespace seneca {
+	// Fill policies: what a station does with the order at the front of its queue
+	struct FillOne {
+		// One item per iteration, as LineManager::run does
+		static constexpr bool c_fillAll = false;
+	};
+	struct FillAll {
+		// Every item the order needs from the station, while stock lasts
+		static constexpr bool c_fillAll = true;
+	};
+
+	// Queue policies: which waiting order a station serves next
+	struct FifoQueue {
+		// Orders in arrival order, as Workstation keeps them
+		template <typename T>
+		class Queue {
+			std::deque<T> m_items;
+		public:
+			bool empty() const { return m_items.empty(); }
+			size_t size() const { return m_items.size(); }
+			T& top() { return m_items.front(); }
+			void push(T&& item) { m_items.push_back(std::move(item)); }
+			T pop() {
+				T item = std::move(m_items.front());
+				m_items.pop_front();
+				return item;
+			}
+		};
+	};
+	struct PriorityQueue {
+		// Orders with the fewest unfilled items first, then in admission order.
+		// Filling the top order only raises its priority, so the heap stays valid.
+		template <typename T>
+		class Queue {
+			std::vector<T> m_items;
+			static bool later(const T& a, const T& b) { return T::isBefore(b, a); }
+		public:
+			bool empty() const { return m_items.empty(); }
+			size_t size() const { return m_items.size(); }
+			T& top() { return m_items.front(); }
+			void push(T&& item) {
+				m_items.push_back(std::move(item));
+				std::push_heap(m_items.begin(), m_items.end(), later);
+			}
+			T pop() {
+				std::pop_heap(m_items.begin(), m_items.end(), later);
+				T item = std::move(m_items.back());
+				m_items.pop_back();
+				return item;
+			}
+		};
+	};
+
+	// Log policies: LogOn writes LineManager's iteration and fill lines (still
+	// subject to the log level); LogOff removes them from the tick loop
+	struct LogOn {
+		static constexpr bool c_enabled = true;
+	};
+	struct LogOff {
+		static constexpr bool c_enabled = false;
+	};
+
+	// Run-time handle on any instantiation of PolicyEngine
+	class LineEngine {
+	public:
+		virtual ~LineEngine() = default;
+		// One iteration; returns true once every order has left the line
+		virtual bool step(std::ostream& os) = 0;
+		virtual SimulationResult run(std::ostream& os) = 0;
+		virtual SimulationResult getResult() const = 0;
+		virtual const std::deque<CustomerOrder>& getCompleted() const = 0;
+		virtual const std::deque<CustomerOrder>& getIncomplete() const = 0;
+		// Every station of the scenario in load order, with its remaining stock
+		virtual const std::vector<Station>& getStations() const = 0;
+	};
+
+	// A line whose fill, queue and logging behavior are fixed at compile time,
+	// so the tick loop carries no branches for features it does not use.
+	// Built from a Scenario like SimulationContext, and owning its stations and
+	// orders, it shares nothing with other engines or the global queues.
+	// PolicyEngine<FillOne, FifoQueue, LogOn> matches LineManager::run
+	// iteration for iteration, log included.
+	//
+	// The member definitions live in PolicyEngine.cpp, which instantiates
+	// every combination of the policies above.
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	class PolicyEngine final : public LineEngine {
+	public:
+		// An order in flight, with each item resolved to its line position
+		struct EngineOrder {
+			CustomerOrder m_order;
+			std::vector<uint32_t> m_itemStations;	// position on the line, or c_offLine
+			size_t m_unfilled{0};
+			size_t m_sequence{0};
+			static bool isBefore(const EngineOrder& a, const EngineOrder& b) {
+				return a.m_unfilled != b.m_unfilled ? a.m_unfilled < b.m_unfilled : a.m_sequence < b.m_sequence;
+			}
+		};
+		static const uint32_t c_offLine = UINT32_MAX;
+	private:
+		std::vector<Station> m_stations;
+		std::vector<size_t> m_line;		// indices into m_stations in travel order
+		std::vector<typename QueuePolicy::template Queue<EngineOrder>> m_queues;
+		std::deque<EngineOrder> m_pending;
+		std::deque<CustomerOrder> m_completed;
+		std::deque<CustomerOrder> m_incomplete;
+		size_t m_orders{0};
+		size_t m_iteration{0};
+		void fill(size_t position, std::ostream& os);
+		bool isDone(const EngineOrder& order, size_t position) const;
+	public:
+		PolicyEngine(const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay = InventoryOverlay());
+		explicit PolicyEngine(const Scenario& scenario);
+		bool step(std::ostream& os) override;
+		SimulationResult run(std::ostream& os) override;
+		SimulationResult getResult() const override;
+		const std::deque<CustomerOrder>& getCompleted() const override;
+		const std::deque<CustomerOrder>& getIncomplete() const override;
+		const std::vector<Station>& getStations() const override;
+	};
+
+	extern template class PolicyEngine<FillOne, FifoQueue, LogOn>;
+	extern template class PolicyEngine<FillOne, FifoQueue, LogOff>;
+	extern template class PolicyEngine<FillOne, PriorityQueue, LogOn>;
+	extern template class PolicyEngine<FillOne, PriorityQueue, LogOff>;
+	extern template class PolicyEngine<FillAll, FifoQueue, LogOn>;
+	extern template class PolicyEngine<FillAll, FifoQueue, LogOff>;
+	extern template class PolicyEngine<FillAll, PriorityQueue, LogOn>;
+	extern template class PolicyEngine<FillAll, PriorityQueue, LogOff>;
+
+	// The fast path: LineManager's behavior without logging
+	using FastEngine = PolicyEngine<FillOne, FifoQueue, LogOff>;
+
+	struct EnginePolicies {
+		bool m_fillAll{false};
+		bool m_priority{false};
+		bool m_logging{true};
+	};
+
+	// Comma-separated policies, any of "fill-one", "fill-all", "fifo",
+	// "priority", "log" and "quiet"; unnamed ones keep LineManager's behavior
+	EnginePolicies parseEnginePolicies(const std::string& spec);
+	// Picks the matching instantiation
+	std::unique_ptr<LineEngine> makeLineEngine(const EnginePolicies& policies, const Scenario& scenario,
+		const std::vector<std::string>& line, const InventoryOverlay& overlay = InventoryOverlay());
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef SENECA_PROFILER_H
+#define SENECA_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace seneca {
+	// Raw timestamp for zones: the TSC on x86, steady_clock nanoseconds elsewhere
+	inline uint64_t readProfileClock() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	// A named zone (time spent inside a scope) or counter (a running total).
+	// Zones are registered once and live until the program ends.
+	struct ProfileZone {
+		const char* m_name{nullptr};
+		bool m_timed{true};
+		std::atomic<uint64_t> m_calls{0};
+		std::atomic<uint64_t> m_total{0};	// clock ticks for a zone, the counted amount for a counter
+	};
+
+	// Returns the zone registered under the name, registering it on first use
+	ProfileZone& getProfileZone(const char* name, bool timed);
+	// Every zone in the order they were first entered
+	std::vector<const ProfileZone*> getProfileZones();
+	// Zeroes every zone and restarts the wall clock the report measures against
+	void resetProfile();
+	double getProfileClockRate();
+	// Table of zones with calls, total and mean time and share of wall time,
+	// followed by the counters
+	void writeProfile(std::ostream& os);
+	// Writes the table to std::cerr when the program exits
+	void writeProfileAtExit();
+
+	// Adds the time between construction and destruction to a zone
+	class ScopedZone {
+		ProfileZone& m_zone;
+		uint64_t m_start;
+	public:
+		explicit ScopedZone(ProfileZone& zone) : m_zone(zone), m_start(readProfileClock()) {}
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+		~ScopedZone() {
+			m_zone.m_total.fetch_add(readProfileClock() - m_start, std::memory_order_relaxed);
+			m_zone.m_calls.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+}
+
+// Instrumentation points. Without SENECA_PROFILING (the PROFILING option in
+// CMakeLists.txt) they expand to nothing.
+#define SENECA_PROFILE_JOIN2(a, b) a##b
+#define SENECA_PROFILE_JOIN(a, b) SENECA_PROFILE_JOIN2(a, b)
+
+#ifdef SENECA_PROFILING
+// Times the rest of the enclosing scope
+#define SENECA_PROFILE_ZONE(name) \
+	static seneca::ProfileZone& SENECA_PROFILE_JOIN(seneca_zone_, __LINE__) = seneca::getProfileZone(name, true); \
+	seneca::ScopedZone SENECA_PROFILE_JOIN(seneca_scope_, __LINE__)(SENECA_PROFILE_JOIN(seneca_zone_, __LINE__))
+// Adds amount to a counter
+#define SENECA_PROFILE_COUNT(name, amount) \
+	do { \
+		static seneca::ProfileZone& seneca_counter = seneca::getProfileZone(name, false); \
+		seneca_counter.m_calls.fetch_add(1, std::memory_order_relaxed); \
+		seneca_counter.m_total.fetch_add(amount, std::memory_order_relaxed); \
+	} while (false)
+#define SENECA_PROFILE_REPORT_AT_EXIT() seneca::writeProfileAtExit()
+#else
+#define SENECA_PROFILE_ZONE(name) static_cast<void>(0)
+#define SENECA_PROFILE_COUNT(name, amount) static_cast<void>(0)
+#define SENECA_PROFILE_REPORT_AT_EXIT() static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SENECA_REPORTWRITER_H
+#define SENECA_REPORTWRITER_H
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <string>
+#include "CustomerOrder.h"
+#include "OutputBuffer.h"
+#include "Station.h"
+
+namespace seneca {
+	enum class ReportFormat {
+		Csv,
+		JsonLines
+	};
+
+	// "csv" or "jsonl"
+	ReportFormat parseReportFormat(const std::string& name);
+	// From a file name's extension: .csv, or .jsonl/.ndjson
+	ReportFormat getReportFormat(const std::string& file);
+
+	// Streams a run's results for other programs to read. Records go through
+	// an OutputBuffer as they are written, with numbers and text copied in
+	// directly instead of formatted by the stream.
+	//
+	// CSV has one row per order item and one per station, under the header
+	//	record,id,name,product,item,serial,filled,quantity,description
+	// where record is completed, incomplete or station, and columns that do
+	// not apply to the row are empty. JSON Lines has one object per order,
+	// with its items and the names of the ones still missing, and one per station.
+	class ReportWriter {
+		OutputBuffer m_output;
+		ReportFormat m_format;
+		void writeCsvField(const std::string& text);
+		void writeJsonString(const std::string& text);
+	public:
+		ReportWriter(std::ostream& os, ReportFormat format);
+		ReportWriter(const ReportWriter&) = delete;
+		ReportWriter& operator=(const ReportWriter&) = delete;
+		void writeOrder(const CustomerOrder& order, bool completed);
+		void writeStation(const Station& station);
+		// Completed orders, then incomplete ones, then the stations
+		template <typename Stations>
+		void writeResults(const std::deque<CustomerOrder>& completed, const std::deque<CustomerOrder>& incomplete, const Stations& stations);
+		void flush();
+	};
+
+	// Stations may be held by value, by pointer or by unique_ptr
+	inline const Station& reportedStation(const Station& station) {
+		return station;
+	}
+	inline const Station& reportedStation(const Station* station) {
+		return *station;
+	}
+	template <typename T>
+	const Station& reportedStation(const std::unique_ptr<T>& station) {
+		return *station;
+	}
+
+	template <typename Stations>
+	void ReportWriter::writeResults(const std::deque<CustomerOrder>& completed, const std::deque<CustomerOrder>& incomplete, const Stations& stations) {
+		for (const auto& order : completed) writeOrder(order, true);
+		for (const auto& order : incomplete) writeOrder(order, false);
+		for (const auto& station : stations) writeStation(reportedStation(station));
+		flush();
+	}
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef SENECA_RESULTSINK_H
+#define SENECA_RESULTSINK_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include "CustomerOrder.h"
+
+namespace seneca {
+	// Takes orders as they leave the last station. A line without a sink
+	// keeps them in g_completed and g_incomplete; a line with one hands every
+	// finished order over and keeps nothing itself.
+	class ResultSink {
+	public:
+		virtual ~ResultSink() = default;
+		virtual void accept(CustomerOrder&& order, bool completed) = 0;
+		virtual size_t getCompletedCount() const = 0;
+		virtual size_t getIncompleteCount() const = 0;
+	};
+
+	// Appends finished orders to a binary file and keeps only their counts,
+	// so memory no longer grows with the number of orders run. Each record is
+	// the completed flag followed by the order in checkpoint encoding; read
+	// the file back with SpillFileReader once the run is over.
+	class SpillFileSink : public ResultSink {
+		std::string m_file;
+		std::ofstream m_os;
+		size_t m_completed{0};
+		size_t m_incomplete{0};
+	public:
+		// Replaces any existing file
+		explicit SpillFileSink(const std::string& file);
+		SpillFileSink(const SpillFileSink&) = delete;
+		SpillFileSink& operator=(const SpillFileSink&) = delete;
+		void accept(CustomerOrder&& order, bool completed) override;
+		size_t getCompletedCount() const override;
+		size_t getIncompleteCount() const override;
+		// Writes out everything accepted so far; call before reading the file
+		void flush();
+		const std::string& getFile() const;
+	};
+
+	// Reads a spill file one order at a time, in the order they finished
+	class SpillFileReader {
+		std::ifstream m_is;
+	public:
+		explicit SpillFileReader(const std::string& file);
+		bool next(CustomerOrder& order, bool& completed);
+	};
+
+	// Calls fn(order) for every spilled order that is completed (or not)
+	template <typename F>
+	void readSpillFile(const std::string& file, bool completed, F&& fn) {
+		SpillFileReader reader(file);
+		CustomerOrder order;
+		bool isCompleted = false;
+		while (reader.next(order, isCompleted)) {
+			if (isCompleted == completed) fn(static_cast<const CustomerOrder&>(order));
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef SENECA_SCENARIO_H
+#define SENECA_SCENARIO_H
+
+#include <string>
+#include <vector>
+#include "CustomerOrder.h"
+#include "Station.h"
+
+namespace seneca {
+	// Parsed, read-only copy of a simulation's input files. Simulations never
+	// run against a Scenario directly; they instantiate a SimulationContext from it.
+	//
+	// Stations are numbered by their position here, and the display widths are
+	// those of this Scenario's own files, so neither depends on what else the
+	// process has loaded.
+	class Scenario {
+		std::vector<Station> m_stations;
+		std::vector<CustomerOrder> m_orders;
+		std::vector<std::string> m_line;
+		size_t m_stationWidth{0};
+		size_t m_orderWidth{0};
+		void numberStations();
+	public:
+		void loadStations(const std::string& file, char delimiter);
+		void loadOrders(const std::string& file, char delimiter);
+		void loadLine(const std::string& file, char delimiter = '|');
+		void setLine(const std::vector<std::string>& line);
+		// Stations and orders built elsewhere bring no widths of their own, so
+		// these take the shared Station and CustomerOrder widths
+		void addStations(const std::vector<Station>& stations);
+		void addOrders(const std::vector<CustomerOrder>& orders);
+		// Appends another Scenario's stations or orders along with its widths
+		void addStations(const Scenario& other);
+		void addOrders(const Scenario& other);
+		const std::vector<Station>& getStations() const;
+		const std::vector<CustomerOrder>& getOrders() const;
+		const std::vector<std::string>& getLine() const;
+		// The name column of Station::display and the item column of CustomerOrder::display
+		size_t getStationWidth() const;
+		size_t getOrderWidth() const;
+		const Station* findStation(const std::string& itemName) const;
+	};
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SENECA_SCENARIOGENERATOR_H
+#define SENECA_SCENARIOGENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace seneca {
+	struct GeneratorSpec {
+		size_t m_itemTypes{10};
+		size_t m_orders{1000};
+		size_t m_minItems{1};			// items per order, uniform in [min, max]
+		size_t m_maxItems{5};
+		double m_zipf{0.0};				// popularity skew; item k is picked with weight 1 / k^zipf
+		double m_stock{1.0};			// station stock as a fraction of the item's expected demand
+		size_t m_lineLength{0};			// stations in the line; 0 means every item type
+		uint64_t m_seed{1};
+	};
+
+	// Builds synthetic scenarios from a GeneratorSpec. The same spec always
+	// produces the same stations, orders and line, on any platform: every
+	// random choice is drawn from std::mt19937_64 without the library's
+	// implementation-defined distributions.
+	class ScenarioGenerator {
+		GeneratorSpec m_spec;
+		std::vector<std::string> m_items;
+		// Walker alias table over m_items: pick a slot uniformly, then keep it
+		// with probability m_keep[slot] or take m_alias[slot] instead
+		std::vector<double> m_keep;
+		std::vector<size_t> m_alias;
+		std::vector<size_t> m_quantities;
+		std::vector<size_t> m_lineItems;	// indices into m_items, in line order
+		std::vector<std::string> m_line;
+	public:
+		explicit ScenarioGenerator(const GeneratorSpec& spec);
+		const GeneratorSpec& getSpec() const;
+		const std::vector<std::string>& getItems() const;
+		const std::vector<std::string>& getLine() const;
+		const std::vector<size_t>& getLineItems() const;
+		// "Name<d>serial<d>quantity<d>description" for item `index`
+		std::string getStationRecord(size_t index, char delimiter) const;
+		// Writes the stations [first, last) of getItems()
+		void writeStations(std::ostream& os, size_t first, size_t last, char delimiter) const;
+		// AssemblyLine.txt format
+		void writeLine(std::ostream& os) const;
+		void writeOrders(std::ostream& os) const;
+		// Calls fn(record) with each '|'-delimited order record in turn; the
+		// record is reused between calls
+		template <typename Function>
+		void forEachOrder(Function fn) const;
+	private:
+		size_t pickItem(std::mt19937_64& random) const;
+		void appendOrder(std::string& record, size_t index, std::mt19937_64& random) const;
+	};
+
+	template <typename Function>
+	void ScenarioGenerator::forEachOrder(Function fn) const {
+		// Orders draw from their own stream so they never depend on the line
+		std::mt19937_64 random(m_spec.m_seed * 2 + 1);
+		std::string record;
+		for (size_t i = 0; i < m_spec.m_orders; i++) {
+			record.clear();
+			appendOrder(record, i, random);
+			fn(record);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SENECA_SHAREDINVENTORY_H
+#define SENECA_SHAREDINVENTORY_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Scenario.h"
+#include "SimulationContext.h"
+#include "Station.h"
+
+namespace seneca {
+	// How lines share an item that runs short
+	enum class InventoryFairness {
+		FirstCome,		// whichever line gets there first
+		EqualShare		// each line owns an equal share; the rest is common
+	};
+
+	// "first-come" or "equal-share"
+	InventoryFairness parseInventoryFairness(const std::string& name);
+
+	// What one line saw of one item
+	struct InventoryContention {
+		size_t m_requests{0};		// reservations asked for
+		size_t m_wanted{0};			// units asked for
+		size_t m_granted{0};		// units received
+		size_t m_shortfalls{0};		// reservations granted less than they asked for
+		size_t m_retries{0};		// attempts lost to another line taking the same stock
+		size_t m_fromPool{0};		// EqualShare: units taken beyond the line's own share
+	};
+
+	// Stock rooms that several lines, each on its own thread, fill orders
+	// from. A Station attached with Station::drawFrom reserves here instead
+	// of from its own stock. Reservations are lock-free: stock is claimed with
+	// a compare-and-swap and serial numbers with one fetch_add, so every unit
+	// and serial number goes to exactly one line.
+	//
+	// Under FirstCome all stock is common. Under EqualShare each line starts
+	// with quantity / lines units that only it can take, the remainder is
+	// common, and a finished line's unused share becomes common too. Lines
+	// only contend for the common stock. Contention counters are kept per
+	// line and written only by that line's thread; read them once the lines
+	// have stopped.
+	class SharedInventory {
+		struct Item {
+			std::string m_name;
+			std::atomic<size_t> m_serialNumber{0};
+			std::atomic<size_t> m_common{0};
+			std::unique_ptr<std::atomic<size_t>[]> m_shares;
+		};
+		InventoryFairness m_fairness;
+		size_t m_lines;
+		std::vector<std::unique_ptr<Item>> m_items;
+		std::vector<std::vector<InventoryContention>> m_contention;
+		size_t takeCommon(Item& item, size_t count, InventoryContention& contention);
+	public:
+		SharedInventory(const std::vector<Station>& stock, size_t lines, InventoryFairness fairness);
+		SharedInventory(const SharedInventory&) = delete;
+		SharedInventory& operator=(const SharedInventory&) = delete;
+		InventoryFairness getFairness() const;
+		size_t getLineCount() const;
+		size_t getItemCount() const;
+		const std::string& getItemName(size_t item) const;
+		// The item's index, or getItemCount() when it is not stocked here
+		size_t indexOf(const std::string& itemName) const;
+		// Stock and serial numbers together, as Station::reserve
+		StationReservation reserve(size_t item, size_t line, size_t count);
+		// Stock alone (returns the units granted) and serial numbers alone
+		// (returns the first), for Station's single-step calls
+		size_t takeStock(size_t item, size_t line, size_t count);
+		size_t takeSerialNumbers(size_t item, size_t count);
+		// Units `line` could still receive
+		size_t getAvailable(size_t item, size_t line) const;
+		// Units left for all lines together
+		size_t getQuantity(size_t item) const;
+		size_t getSerialNumber(size_t item) const;
+		// The line has stopped drawing; under EqualShare its share becomes common
+		void finishLine(size_t line);
+		const InventoryContention& getContention(size_t line, size_t item) const;
+		// One row per item the line asked for
+		void writeContention(std::ostream& os, size_t line) const;
+	};
+
+	// Runs several lines at once, one thread each, against one shared
+	// inventory. The stock comes from one scenario's stations; each line
+	// brings its own orders and layout. A line station whose item the stock
+	// scenario does not have keeps its own stock.
+	class SharedLineRunner {
+		std::vector<Station> m_stock;
+		InventoryFairness m_fairness;
+		std::vector<std::string> m_names;
+		std::vector<std::unique_ptr<SimulationContext>> m_lines;
+		std::unique_ptr<SharedInventory> m_inventory;
+	public:
+		SharedLineRunner(const Scenario& stock, InventoryFairness fairness);
+		void addLine(const std::string& name, const Scenario& line);
+		// Ticks every line to completion; may be called once
+		std::vector<SimulationResult> run();
+		size_t getLineCount() const;
+		const std::string& getLineName(size_t line) const;
+		const SimulationContext& getLine(size_t line) const;
+		const SharedInventory& getInventory() const;
+		// Each line's result and contention, then the stock left
+		void writeReport(std::ostream& os) const;
+	};
+}
+
+#endif
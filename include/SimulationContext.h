@@ -0,0 +1,54 @@
+#ifndef SENECA_SIMULATIONCONTEXT_H
+#define SENECA_SIMULATIONCONTEXT_H
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "CustomerOrder.h"
+#include "Scenario.h"
+#include "Workstation.h"
+
+namespace seneca {
+	struct SimulationResult {
+		size_t m_completed{0};
+		size_t m_incomplete{0};
+		size_t m_iterations{0};
+	};
+
+	// Station quantities that replace the Scenario's stock for a single run.
+	// Stations without an entry keep the quantity they were loaded with.
+	using InventoryOverlay = std::map<std::string, size_t>;
+
+	// One independent run of a Scenario. The context owns fresh copies of the
+	// stations and orders, so any number of contexts built from the same Scenario
+	// can run at once, each on its own thread.
+	class SimulationContext {
+		std::vector<std::unique_ptr<Workstation>> m_stations;
+		std::vector<Workstation*> m_line;
+		std::deque<CustomerOrder> m_orders;
+		std::deque<CustomerOrder> m_completed;
+		std::deque<CustomerOrder> m_incomplete;
+		SimulationResult m_result;
+		SimulationResult simulate(std::ostream* os);
+	public:
+		SimulationContext(const Scenario& scenario);
+		SimulationContext(const Scenario& scenario, const std::vector<std::string>& line);
+		SimulationContext(const Scenario& scenario, const InventoryOverlay& overlay);
+		SimulationContext(const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay);
+		SimulationContext(const SimulationContext&) = delete;
+		SimulationContext& operator=(const SimulationContext&) = delete;
+		SimulationResult run(std::ostream& os);
+		SimulationResult fastForward();
+		const SimulationResult& getResult() const;
+		const std::deque<CustomerOrder>& getCompleted() const;
+		const std::deque<CustomerOrder>& getIncomplete() const;
+		const std::vector<std::unique_ptr<Workstation>>& getStations() const;
+		Workstation* findStation(const std::string& itemName) const;
+	};
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef SENECA_SIMULATIONOBSERVER_H
+#define SENECA_SIMULATIONOBSERVER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace seneca {
+	class CustomerOrder;
+	class Station;
+	class Workstation;
+
+	// Receives every state change a LineManager run makes, in the order it
+	// happens. Every callback defaults to doing nothing, so observers only
+	// override what they need. Callbacks run on the simulating thread.
+	class SimulationObserver {
+	public:
+		virtual ~SimulationObserver() = default;
+		// A new iteration starts; everything until onIterationEnd belongs to it
+		virtual void onIteration(size_t) {};
+		// An order leaves the pending queue and joins the first station
+		virtual void onAdmit(const Workstation&, const CustomerOrder&) {};
+		// The station worked on the order's item at `item`; `filled` is false
+		// when it had no stock left
+		virtual void onFill(const Station&, const CustomerOrder&, size_t, bool) {};
+		// The order, still at the front of `from`, is about to move to `to`
+		virtual void onMove(const Workstation&, const Workstation&, const CustomerOrder&) {};
+		// The order, still at the front of the last station, leaves the line
+		virtual void onFinish(const Workstation&, const CustomerOrder&, bool) {};
+		virtual void onIterationEnd(size_t) {};
+	};
+
+	// Forwards every callback to several observers, in the order they were added
+	class ObserverList : public SimulationObserver {
+		std::vector<SimulationObserver*> m_observers;
+	public:
+		void add(SimulationObserver* observer) {
+			if (observer) m_observers.push_back(observer);
+		};
+		bool empty() const {
+			return m_observers.empty();
+		};
+		void onIteration(size_t iteration) override {
+			for (auto* observer : m_observers) observer->onIteration(iteration);
+		};
+		void onAdmit(const Workstation& station, const CustomerOrder& order) override {
+			for (auto* observer : m_observers) observer->onAdmit(station, order);
+		};
+		void onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) override {
+			for (auto* observer : m_observers) observer->onFill(station, order, item, filled);
+		};
+		void onMove(const Workstation& from, const Workstation& to, const CustomerOrder& order) override {
+			for (auto* observer : m_observers) observer->onMove(from, to, order);
+		};
+		void onFinish(const Workstation& station, const CustomerOrder& order, bool completed) override {
+			for (auto* observer : m_observers) observer->onFinish(station, order, completed);
+		};
+		void onIterationEnd(size_t iteration) override {
+			for (auto* observer : m_observers) observer->onIterationEnd(iteration);
+		};
+	};
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef SENECA_SIMULATIONSERVER_H
+#define SENECA_SIMULATIONSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Scenario.h"
+#include "ThreadPool.h"
+
+namespace seneca {
+	// A long-running simulator that keeps parsed scenarios in memory and runs
+	// jobs against them on a thread pool. Each job builds its own
+	// SimulationContext (or InventorySweep) from the shared, read-only Scenario.
+	//
+	// Requests are single lines of whitespace-separated words; a word holding
+	// spaces goes in double quotes. Every reply starts with "ok <n>\n" followed
+	// by an n-byte body, or is a single "error <message>\n" line.
+	//
+	//	load <name> <stations1> <stations2> <orders> <line>
+	//	unload <name>
+	//	scenarios
+	//	run <name> [Station=quantity]...		replies "job <id>"
+	//	sweep <name> <axis>...				replies "job <id>"
+	//	status <id>					queued, running, done or failed
+	//	result <id>					waits for the job, then replies with its output
+	//	forget <id>
+	//	shutdown
+	class SimulationServer {
+		struct Job {
+			std::string m_status{"queued"};
+			std::string m_output;
+		};
+		std::map<std::string, std::shared_ptr<const Scenario>> m_scenarios;
+		std::map<size_t, std::shared_ptr<Job>> m_jobs;
+		size_t m_nextJob{1};
+		std::mutex m_lock;
+		std::condition_variable m_jobFinished;
+		std::mutex m_loadLock;		// parsing goes through Utilities' shared delimiter
+		std::atomic<bool> m_stopping{false};
+		std::atomic<int> m_listener{-1};
+		std::vector<std::thread> m_connections;
+		std::vector<std::thread::id> m_finished;	// connections done serving, not yet joined
+		std::vector<int> m_clients;
+		mutable std::mutex m_clientLock;
+		ThreadPool m_pool;
+
+		std::shared_ptr<const Scenario> findScenario(const std::string& name);
+		std::shared_ptr<Job> findJob(const std::string& id);
+		std::string submit(std::function<std::string()> work);
+		void serveClient(int client);
+		void reapConnections();
+	public:
+		explicit SimulationServer(size_t workers = 0);
+		~SimulationServer();
+		SimulationServer(const SimulationServer&) = delete;
+		SimulationServer& operator=(const SimulationServer&) = delete;
+		// Answers one request line; the protocol without the socket
+		std::string handle(const std::string& request);
+		// Listens on a Unix domain socket until a shutdown request or stop()
+		void serve(const std::string& socketPath);
+		void stop();
+		bool isStopping() const;
+		// Connection threads not yet joined; finished ones are joined when the next client connects
+		size_t getConnectionCount() const;
+		static std::vector<std::string> splitRequest(const std::string& request);
+	};
+}
+
+#endif
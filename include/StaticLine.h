@@ -0,0 +1,152 @@
+#ifndef SENECA_STATICLINE_H
+#define SENECA_STATICLINE_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "FastForward.h"
+#include "LineManager.h"
+#include "Station.h"
+#include "Workstation.h"
+
+namespace seneca {
+	// One station of a line fixed at compile time; the fields of a station record
+	struct StaticStation {
+		const char* m_itemName;
+		size_t m_serialNumber;
+		size_t m_quantity;
+		const char* m_description;
+	};
+
+	// One line of AssemblyLine.txt; m_next is nullptr for the end of the line
+	struct StaticLink {
+		const char* m_station;
+		const char* m_next;
+	};
+
+	constexpr bool isSameStaticName(const char* a, const char* b) {
+		while (*a && *a == *b) {
+			a++;
+			b++;
+		}
+		return *a == *b;
+	}
+
+	// Index of the station named `name`, or N if there is none
+	template <size_t N>
+	constexpr size_t findStaticStation(const StaticStation (&stations)[N], const char* name) {
+		for (size_t i = 0; i < N; i++) {
+			if (isSameStaticName(stations[i].m_itemName, name)) return i;
+		}
+		return N;
+	}
+
+	// Station indices in travel order, found the way LineManager finds them in
+	// AssemblyLine.txt: the line starts at the one station that follows no other.
+	// Evaluated in a constant expression, a malformed line fails to compile.
+	template <size_t N, size_t L>
+	constexpr std::array<size_t, L> resolveStaticRoute(const StaticStation (&stations)[N], const StaticLink (&links)[L]) {
+		std::array<size_t, L> next{};
+		for (size_t i = 0; i < L; i++) {
+			if (findStaticStation(stations, links[i].m_station) == N) throw std::string("Unknown station in static line");
+			for (size_t j = 0; j < i; j++) {
+				if (isSameStaticName(links[i].m_station, links[j].m_station)) throw std::string("Station appears twice in static line");
+			}
+			next[i] = L;
+			for (size_t j = 0; links[i].m_next && j < L; j++) {
+				if (isSameStaticName(links[i].m_next, links[j].m_station)) next[i] = j;
+			}
+			if (links[i].m_next && next[i] == L) throw std::string("Static line continues to a station it does not list");
+		}
+
+		size_t first = L;
+		for (size_t i = 0; i < L; i++) {
+			bool followed = false;
+			for (size_t j = 0; j < L; j++) {
+				if (next[j] == i) followed = true;
+			}
+			if (!followed) {
+				if (first != L) throw std::string("Static line has more than one start");
+				first = i;
+			}
+		}
+		if (first == L && L > 0) throw std::string("Static line has no start");
+
+		std::array<size_t, L> route{};
+		size_t link = first;
+		for (size_t i = 0; i < L; i++) {
+			if (link == L) throw std::string("Static line ends before visiting every station");
+			route[i] = findStaticStation(stations, links[link].m_station);
+			link = next[link];
+		}
+		return route;
+	}
+
+	// A production line whose stations and routing are fixed in the source
+	// instead of read from files. Stations and Links are constexpr arrays at
+	// namespace scope; the route is resolved while compiling, so the line holds
+	// its stations in a fixed-size array and never looks a name up. Orders go
+	// through g_pending and the line runs on LineManager as a configured one does.
+	//
+	//	constexpr StaticStation c_stations[] = { {"Desk", 100, 5, "Worktable"}, {"Lamp", 200, 5, "Desk lamp"} };
+	//	constexpr StaticLink c_links[] = { {"Desk", "Lamp"}, {"Lamp", nullptr} };
+	//	StaticLine<c_stations, c_links> line;
+	template <const auto& Stations, const auto& Links>
+	class StaticLine {
+	public:
+		static constexpr size_t c_stationCount = std::size(Stations);
+		static constexpr size_t c_lineLength = std::size(Links);
+		static constexpr std::array<size_t, c_lineLength> c_route = resolveStaticRoute(Stations, Links);
+	private:
+		std::array<Workstation, c_stationCount> m_stations;
+		std::array<Workstation*, c_lineLength> m_line;
+
+		static Station makeStation(size_t index) {
+			return Station(Stations[index].m_itemName, Stations[index].m_serialNumber, Stations[index].m_quantity, Stations[index].m_description);
+		}
+		template <size_t... Indices>
+		StaticLine(std::index_sequence<Indices...>) : m_stations{ { Workstation(makeStation(Indices))... } } {
+			for (size_t i = 0; i < c_lineLength; i++) {
+				m_line[i] = &m_stations[c_route[i]];
+			}
+		}
+	public:
+		StaticLine() : StaticLine(std::make_index_sequence<c_stationCount>()) {}
+		StaticLine(const StaticLine&) = delete;
+		StaticLine& operator=(const StaticLine&) = delete;
+
+		// Compile-time position of a station in Stations, for get<>()
+		static constexpr size_t indexOf(const char* itemName) {
+			return findStaticStation(Stations, itemName);
+		}
+		template <size_t Index>
+		Workstation& get() {
+			static_assert(Index < c_stationCount, "No such station in the static line");
+			return m_stations[Index];
+		}
+		// Every station, in the order Stations lists them
+		std::array<Workstation, c_stationCount>& getStations() {
+			return m_stations;
+		}
+		// The stations in travel order, for LineManager and fastForward
+		std::vector<Workstation*> getLine() const {
+			return std::vector<Workstation*>(m_line.begin(), m_line.end());
+		}
+		// Ticks g_pending through the line, logging to `os`; returns the iterations
+		size_t run(std::ostream& os) {
+			LineManager manager(getLine());
+			while (!manager.run(os));
+			return manager.getIterationCount();
+		}
+		// The result run would reach, without the log
+		size_t fastForward() {
+			return seneca::fastForward(getLine());
+		}
+	};
+}
+
+#endif
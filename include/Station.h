@@ -1,27 +1,72 @@
 #ifndef SENECA_STATION_H
 #define SENECA_STATION_H
 
+#include <atomic>
 #include <cstddef>
+#include <istream>
+#include <ostream>
 #include <string>
 namespace seneca {
+	class OutputBuffer;
+	class SharedInventory;
+
+	// Units of stock taken from a station in one step, with the serial
+	// numbers that go with them: m_firstSerial up to m_firstSerial + m_count
+	struct StationReservation {
+		size_t m_firstSerial{0};
+		size_t m_count{0};
+	};
+
 	class Station {
+		// Atomic so engines running on several threads can fill from one
+		// station; copying a station takes a snapshot
+		struct Stock {
+			std::atomic<size_t> m_serialNumber{0};
+			std::atomic<size_t> m_quantity{0};
+			Stock() = default;
+			Stock(const Stock& src);
+			Stock& operator=(const Stock& src);
+		};
+
 		int m_id;
 		std::string m_itemName;
 		std::string m_description;
-		size_t m_serialNumber;
-		size_t m_quantity;
+		Stock m_stock;
+		SharedInventory* m_inventory{nullptr};
+		size_t m_inventoryItem{0};
+		size_t m_inventoryLine{0};
+		size_t takeStock(size_t count);
 
 		static size_t m_widthField;
 		static int id_generator;
 	public:
 		Station(const std::string& str);
+		Station(const std::string& itemName, size_t serialNumber, size_t quantity, const std::string& description);
+		int getId() const;
+		void setId(int id);
 		const std::string& getItemName() const;
+		const std::string& getDescription() const;
 		size_t getNextSerialNumber();
+		size_t getSerialNumber() const;
 		size_t getQuantity() const;
 		void updateQuantity();
+		void setQuantity(size_t quantity);
+		// Takes up to `count` units and as many consecutive serial numbers;
+		// m_count is what was granted, 0 once the station is out of stock
+		StationReservation reserve(size_t count);
+		// Stock and serial numbers come from the inventory, as `line`, when it
+		// stocks this item (returns false otherwise); nullptr returns the
+		// station to its own stock. A copy draws from the same inventory.
+		bool drawFrom(SharedInventory* inventory, size_t line);
 		void display(std::ostream& os, bool full) const;
+		void display(OutputBuffer& output, bool full) const;
+		// With the name column `width` wide instead of the shared width
+		void display(OutputBuffer& output, bool full, size_t width) const;
+		void saveState(std::ostream& os) const;
+		void loadState(std::istream& is);
 		static void resetWidthField();
 		static size_t getStaticWidthField();
+		static void setStaticWidthField(size_t width);
 	};
 }
 
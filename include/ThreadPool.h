@@ -0,0 +1,33 @@
+#ifndef SENECA_THREADPOOL_H
+#define SENECA_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seneca {
+	// Fixed set of worker threads running submitted tasks in submission order.
+	// Tasks must not throw. Destroying the pool runs the tasks already queued
+	// and then joins the workers.
+	class ThreadPool {
+		std::vector<std::thread> m_workers;
+		std::deque<std::function<void()>> m_tasks;
+		std::mutex m_lock;
+		std::condition_variable m_ready;
+		bool m_stopping{false};
+		void work();
+	public:
+		explicit ThreadPool(size_t workers = 0);
+		~ThreadPool();
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		void submit(std::function<void()> task);
+		size_t getWorkerCount() const;
+	};
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef SENECA_TRACEEXPORTER_H
+#define SENECA_TRACEEXPORTER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "LineManager.h"
+#include "OutputBuffer.h"
+#include "SimulationObserver.h"
+
+namespace seneca {
+	// Streams a run as Chrome Trace Event JSON, ready for chrome://tracing or
+	// the Perfetto UI. Each station is a track; each order's service at a
+	// station, from reaching the front of its queue until it leaves, is a
+	// slice on that track, and a flow arrow joins one order's slices. Time
+	// spent waiting in a station's queue before that is an async span named
+	// after the station, keyed by order id. Fills and stock-outs are instant events. Iteration n spans
+	// [n - 1, n) milliseconds. Events are written as they happen, so memory
+	// use does not grow with the run. Attach it with LineManager::setObserver
+	// before the first iteration and call finish() (or destroy it) after the
+	// last one to close the JSON.
+	class TraceExporter : public SimulationObserver {
+		OutputBuffer m_output;
+		std::unordered_map<const Station*, size_t> m_stationIndex;
+		std::unordered_map<size_t, size_t> m_arrived;	// order id -> arrival time (us)
+		std::unordered_map<size_t, bool> m_flowing;		// order id -> has a flow started
+		std::vector<size_t> m_departed;					// station -> last departure (us)
+		size_t m_iteration{0};
+		size_t m_firstIteration{0};
+		bool m_finished{false};
+		size_t indexOf(const Station& station) const;
+		void beginEvent();
+		void writeString(const std::string& text);
+		void writeSlice(const Station& from, const CustomerOrder& order, bool last);
+	public:
+		TraceExporter(std::ostream& os, const LineManager& manager);
+		~TraceExporter();
+		TraceExporter(const TraceExporter&) = delete;
+		TraceExporter& operator=(const TraceExporter&) = delete;
+		void onIteration(size_t iteration) override;
+		void onAdmit(const Workstation& station, const CustomerOrder& order) override;
+		void onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) override;
+		void onMove(const Workstation& from, const Workstation& to, const CustomerOrder& order) override;
+		void onFinish(const Workstation& station, const CustomerOrder& order, bool completed) override;
+		void finish();
+	};
+}
+
+#endif
@@ -4,18 +4,24 @@
 #include <cstddef>
 #include <deque>
 #include "CustomerOrder.h"
+#include "ResultSink.h"
+#include "SimulationObserver.h"
 #include "Station.h"
 
 namespace seneca {
-	extern std::deque<CustomerOrder> g_pending;
-	extern std::deque<CustomerOrder> g_completed;
-	extern std::deque<CustomerOrder> g_incomplete;
+	// Each thread owns its own queues so independent simulations can run side by side
+	extern thread_local std::deque<CustomerOrder> g_pending;
+	extern thread_local std::deque<CustomerOrder> g_completed;
+	extern thread_local std::deque<CustomerOrder> g_incomplete;
 
 	class Workstation : public Station {
 		std::deque<CustomerOrder> m_orders;
 		Workstation* m_pNextStaion;
+		SimulationObserver* m_observer{nullptr};
+		ResultSink* m_sink{nullptr};
 	public:
 		Workstation(const std::string&);
+		explicit Workstation(const Station& prototype);
 		Workstation(const Workstation&) = delete;
 		Workstation& operator=(Workstation&) = delete;
 		Workstation(const Workstation&&) = delete;
@@ -24,8 +30,14 @@ namespace seneca {
 		bool attemptToMoveOrder();
 		void setNextStation(Workstation* station = nullptr);
 		Workstation* getNextStation() const;
+		size_t getQueueLength() const;
+		void setObserver(SimulationObserver* observer);
+		void setResultSink(ResultSink* sink);
 		void display(std::ostream& os) const;
+		void display(OutputBuffer& output) const;
 		Workstation& operator+=(CustomerOrder&& newOrder);
+		void saveState(std::ostream& os) const;
+		void loadState(std::istream& is);
 	};
 }
 
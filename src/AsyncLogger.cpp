@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "AsyncLogger.h"
+#include "CustomerOrder.h"
+#include "LogLevel.h"
+#include "MemoryTracker.h"
+
+namespace seneca {
+	namespace {
+		enum RecordType : uint8_t {
+			IterationRecord = 1,
+			FilledRecord,
+			UnableToFillRecord
+		};
+	}
+
+	AsyncLogger::AsyncLogger(std::ostream& os, size_t capacity) : m_output(os) {
+		SENECA_MEMORY_TAG(LogFormatting);
+		// A power of two lets positions wrap with a mask
+		size_t size = 64;
+		while (size < capacity) size <<= 1;
+		m_ring.resize(size);
+		m_mask = size - 1;
+		m_writer = std::thread(&AsyncLogger::writerLoop, this);
+	};
+
+	AsyncLogger::~AsyncLogger() {
+		close();
+	};
+
+	void AsyncLogger::close() {
+		if (!m_writer.joinable()) return;
+		m_closing.store(true, std::memory_order_release);
+		m_writer.join();
+		m_output.flush();
+	};
+
+	// Waits until the writer has made room for a record of `size` bytes
+	void AsyncLogger::reserve(size_t size) {
+		if (size > m_ring.size()) throw std::string("Log record is larger than the log buffer.");
+		size_t head = m_head.load(std::memory_order_relaxed);
+		while (m_ring.size() - (head - m_tail.load(std::memory_order_acquire)) < size) {
+			std::this_thread::yield();
+		};
+		m_reserved = head;
+	};
+
+	void AsyncLogger::put(const void* data, size_t size) {
+		const char* bytes = static_cast<const char*>(data);
+		size_t offset = m_reserved & m_mask;
+		size_t first = std::min(size, m_ring.size() - offset);
+		std::memcpy(m_ring.data() + offset, bytes, first);
+		std::memcpy(m_ring.data(), bytes + first, size - first);
+		m_reserved += size;
+	};
+
+	void AsyncLogger::putString(const std::string& text) {
+		uint32_t size = static_cast<uint32_t>(text.size());
+		put(&size, sizeof(size));
+		put(text.data(), size);
+	};
+
+	// Makes everything put since reserve() visible to the writer in one step
+	void AsyncLogger::publish() {
+		m_head.store(m_reserved, std::memory_order_release);
+	};
+
+	void AsyncLogger::get(size_t& position, void* data, size_t size) const {
+		char* bytes = static_cast<char*>(data);
+		size_t offset = position & m_mask;
+		size_t first = std::min(size, m_ring.size() - offset);
+		std::memcpy(bytes, m_ring.data() + offset, first);
+		std::memcpy(bytes + first, m_ring.data(), size - first);
+		position += size;
+	};
+
+	// Copies a string straight from the ring to the output
+	void AsyncLogger::writeString(size_t& position) {
+		uint32_t size = 0;
+		get(position, &size, sizeof(size));
+		size_t offset = position & m_mask;
+		size_t first = std::min<size_t>(size, m_ring.size() - offset);
+		m_output.write(m_ring.data() + offset, first);
+		m_output.write(m_ring.data(), size - first);
+		position += size;
+	};
+
+	void AsyncLogger::onIteration(size_t iteration) {
+		if (!isLogEnabled<LogLevel::Iteration>()) return;
+		uint8_t type = IterationRecord;
+		reserve(sizeof(type) + sizeof(iteration));
+		put(&type, sizeof(type));
+		put(&iteration, sizeof(iteration));
+		publish();
+	};
+
+	void AsyncLogger::onFill(const Station&, const CustomerOrder& order, size_t item, bool filled) {
+		if (!isLogEnabled<LogLevel::Fill>()) return;
+		uint8_t type = filled ? FilledRecord : UnableToFillRecord;
+		const std::string& name = order.getName();
+		const std::string& product = order.getProduct();
+		const std::string& itemName = order.getItemName(item);
+		reserve(sizeof(type) + 3 * sizeof(uint32_t) + name.size() + product.size() + itemName.size());
+		put(&type, sizeof(type));
+		putString(name);
+		putString(product);
+		putString(itemName);
+		publish();
+	};
+
+	// Formats every published record; returns how many bytes it consumed
+	size_t AsyncLogger::drain() {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t head = m_head.load(std::memory_order_acquire);
+		size_t start = tail;
+
+		while (tail != head) {
+			uint8_t type = 0;
+			get(tail, &type, sizeof(type));
+			if (type == IterationRecord) {
+				size_t iteration = 0;
+				get(tail, &iteration, sizeof(iteration));
+				m_output << "Line Manager Iteration: " << iteration << '\n';
+			}
+			else {
+				m_output << (type == FilledRecord ? "    Filled " : "    Unable to fill ");
+				writeString(tail);
+				m_output << ", ";
+				writeString(tail);
+				m_output << " [";
+				writeString(tail);
+				m_output << "]\n";
+			};
+			// Hand the space back as soon as each record is formatted
+			m_tail.store(tail, std::memory_order_release);
+		};
+		return tail - start;
+	};
+
+	void AsyncLogger::writerLoop() {
+		SENECA_MEMORY_TAG(LogFormatting);
+		while (true) {
+			bool closing = m_closing.load(std::memory_order_acquire);
+			if (drain() > 0) continue;
+			if (closing) break;
+
+			// Nothing to do: let a slow simulation see its log promptly
+			if (m_output.getPending() > 0) m_output.flush();
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		};
+	};
+}
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "BatchRunner.h"
+#include "OutputBuffer.h"
+#include "Parallel.h"
+#include "PolicyEngine.h"
+#include "ReportWriter.h"
+
+namespace seneca {
+	namespace {
+		std::string trim(const std::string& text) {
+			size_t first = text.find_first_not_of(" \t\r");
+			if (first == std::string::npos) return "";
+			return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+		};
+
+		// "file.txt |" -> {"file.txt", '|'}; a value without a trailing
+		// single-character word keeps the default delimiter
+		BatchInputFile parseInputFile(const std::string& value, char delimiter) {
+			size_t space = value.find_last_of(" \t");
+			if (space != std::string::npos && space + 2 == value.size()) {
+				return BatchInputFile{ trim(value.substr(0, space)), value.back() };
+			};
+			return BatchInputFile{ value, delimiter };
+		};
+
+		// The listing batch mode prints after a run, at the scenario's own
+		// widths so other scenarios of the manifest cannot widen its columns
+		template <typename Stations>
+		void writeListing(std::ostream& os, const Scenario& scenario, const std::deque<CustomerOrder>& completed, const std::deque<CustomerOrder>& incomplete, const Stations& stations) {
+			OutputBuffer output(os);
+			output << "\nCompleted Orders:\n";
+			for (const auto& order : completed) {
+				order.display(output, scenario.getOrderWidth());
+			};
+			output << "\nIncomplete Orders:\n";
+			for (const auto& order : incomplete) {
+				order.display(output, scenario.getOrderWidth());
+			};
+			output << "\nRemaining Inventory:\n";
+			for (const auto& station : stations) {
+				reportedStation(station).display(output, true, scenario.getStationWidth());
+			};
+		};
+	}
+
+	BatchRunner::BatchRunner(size_t workers) : m_workers(workers) {};
+
+	void BatchRunner::addJob(const BatchJob& job) {
+		if (job.m_name.empty() || job.m_name.find_first_of("/\\") != std::string::npos) throw std::string("Invalid scenario name: ") + job.m_name;
+		if (job.m_stations.empty() || job.m_orders.m_file.empty() || job.m_line.empty()) {
+			throw std::string("Scenario ") + job.m_name + " needs stations, orders and line files";
+		};
+		for (const auto& other : m_jobs) {
+			if (other.m_name == job.m_name) throw std::string("Duplicate scenario in manifest: ") + job.m_name;
+		};
+		if (job.m_engine != "fast-forward" && job.m_engine != "tick") parseEnginePolicies(job.m_engine);
+		if (!job.m_report.empty()) parseReportFormat(job.m_report);
+		m_jobs.push_back(job);
+	};
+
+	void BatchRunner::loadManifest(const std::string& file) {
+		std::ifstream ifile(file);
+		if (!ifile) throw std::string("Unable to open ") + file;
+		std::filesystem::path base = std::filesystem::path(file).parent_path();
+		auto resolve = [&](const std::string& path) {
+			return std::filesystem::path(path).is_absolute() ? path : (base / path).string();
+		};
+
+		BatchJob job;
+		bool open = false;
+		std::string text;
+		size_t number = 0;
+		while (std::getline(ifile, text)) {
+			number++;
+			text = trim(text);
+			if (text.empty() || text[0] == '#') continue;
+			std::string where = file + ":" + std::to_string(number);
+
+			if (text.front() == '[') {
+				if (text.back() != ']') throw std::string("Unterminated section at ") + where;
+				if (open) addJob(job);
+				job = BatchJob();
+				job.m_name = trim(text.substr(1, text.size() - 2));
+				open = true;
+				continue;
+			};
+
+			size_t equals = text.find('=');
+			if (equals == std::string::npos) throw std::string("Expected key = value at ") + where;
+			if (!open) throw std::string("Setting outside a scenario at ") + where;
+			std::string key = trim(text.substr(0, equals));
+			std::string value = trim(text.substr(equals + 1));
+
+			if (key == "stations") {
+				BatchInputFile input = parseInputFile(value, ',');
+				input.m_file = resolve(input.m_file);
+				job.m_stations.push_back(input);
+			}
+			else if (key == "orders") {
+				job.m_orders = parseInputFile(value, '|');
+				job.m_orders.m_file = resolve(job.m_orders.m_file);
+			}
+			else if (key == "line") {
+				job.m_line = resolve(value);
+			}
+			else if (key == "engine") {
+				job.m_engine = value;
+			}
+			else if (key == "report") {
+				job.m_report = value;
+			}
+			else if (key == "stock") {
+				size_t split = value.find('=');
+				if (split == std::string::npos) throw std::string("Expected stock = Station=quantity at ") + where;
+				try {
+					job.m_stock[trim(value.substr(0, split))] = std::stoul(value.substr(split + 1));
+				} catch (const std::logic_error&) {
+					throw std::string("Invalid stock quantity at ") + where;
+				};
+			}
+			else {
+				throw std::string("Unknown manifest key '") + key + "' at " + where;
+			};
+		};
+		if (open) addJob(job);
+	};
+
+	const std::vector<BatchJob>& BatchRunner::getJobs() const {
+		return m_jobs;
+	};
+
+	// Builds the job's Scenario from cached file parses, or reuses the whole
+	// Scenario when an earlier job named the same inputs
+	std::shared_ptr<const Scenario> BatchRunner::prepare(const BatchJob& job) {
+		std::string key;
+		for (const auto& input : job.m_stations) {
+			key += input.m_file + '\n' + input.m_delimiter + '\n';
+		};
+		key += job.m_orders.m_file + '\n' + job.m_orders.m_delimiter + '\n' + job.m_line;
+		auto found = m_scenarios.find(key);
+		if (found != m_scenarios.end()) return found->second;
+
+		auto parse = [&](std::map<std::string, std::shared_ptr<const Scenario>>& cache, const BatchInputFile& input, bool stations) {
+			std::string fileKey = input.m_file + '\n' + input.m_delimiter;
+			auto cached = cache.find(fileKey);
+			if (cached != cache.end()) return cached->second;
+
+			auto part = std::make_shared<Scenario>();
+			if (stations) part->loadStations(input.m_file, input.m_delimiter);
+			else part->loadOrders(input.m_file, input.m_delimiter);
+			m_filesParsed++;
+			cache[fileKey] = part;
+			return std::shared_ptr<const Scenario>(part);
+		};
+
+		auto scenario = std::make_shared<Scenario>();
+		for (const auto& input : job.m_stations) {
+			scenario->addStations(*parse(m_stationFiles, input, true));
+		};
+		scenario->addOrders(*parse(m_orderFiles, job.m_orders, false));
+		// The line's pairs resolve against this scenario's stations, so it is not shared
+		scenario->loadLine(job.m_line);
+		m_filesParsed++;
+
+		m_scenarios[key] = scenario;
+		return scenario;
+	};
+
+	std::vector<BatchOutcome> BatchRunner::run(const std::string& directory) {
+		std::filesystem::create_directories(directory);
+		std::vector<BatchOutcome> outcomes(m_jobs.size());
+		std::vector<std::shared_ptr<const Scenario>> scenarios(m_jobs.size());
+
+		// Parsing shares Utilities' delimiter, so inputs are prepared on this thread
+		for (size_t i = 0; i < m_jobs.size(); i++) {
+			outcomes[i].m_name = m_jobs[i].m_name;
+			try {
+				scenarios[i] = prepare(m_jobs[i]);
+			} catch (const std::string& msg) {
+				outcomes[i].m_error = msg;
+			} catch (const std::exception& e) {
+				outcomes[i].m_error = e.what();
+			};
+		};
+
+		parallelFor(m_jobs.size(), m_workers, [&](size_t i) {
+			if (!scenarios[i]) return;
+			const BatchJob& job = m_jobs[i];
+			try {
+				std::string file = (std::filesystem::path(directory) / (job.m_name + ".txt")).string();
+				std::ofstream os(file);
+				if (!os) throw std::string("Unable to open ") + file;
+				std::ofstream reportFile;
+				if (!job.m_report.empty()) {
+					std::string report = (std::filesystem::path(directory) / (job.m_name + "." + job.m_report)).string();
+					reportFile.open(report);
+					if (!reportFile) throw std::string("Unable to open ") + report;
+				};
+
+				if (job.m_engine == "fast-forward" || job.m_engine == "tick") {
+					SimulationContext context(*scenarios[i], job.m_stock);
+					outcomes[i].m_result = job.m_engine == "tick" ? context.run(os) : context.fastForward();
+					writeListing(os, *scenarios[i], context.getCompleted(), context.getIncomplete(), context.getStations());
+					if (reportFile.is_open()) {
+						ReportWriter(reportFile, parseReportFormat(job.m_report)).writeResults(context.getCompleted(), context.getIncomplete(), context.getStations());
+					};
+				} else {
+					std::unique_ptr<LineEngine> engine = makeLineEngine(parseEnginePolicies(job.m_engine), *scenarios[i], scenarios[i]->getLine(), job.m_stock);
+					outcomes[i].m_result = engine->run(os);
+					writeListing(os, *scenarios[i], engine->getCompleted(), engine->getIncomplete(), engine->getStations());
+					if (reportFile.is_open()) {
+						ReportWriter(reportFile, parseReportFormat(job.m_report)).writeResults(engine->getCompleted(), engine->getIncomplete(), engine->getStations());
+					};
+				};
+			} catch (const std::string& msg) {
+				outcomes[i].m_error = msg;
+			} catch (const std::exception& e) {
+				outcomes[i].m_error = e.what();
+			};
+		});
+
+		std::string summary = (std::filesystem::path(directory) / "summary.txt").string();
+		std::ofstream os(summary);
+		if (!os) throw std::string("Unable to open ") + summary;
+		writeSummary(os, outcomes);
+		return outcomes;
+	};
+
+	size_t BatchRunner::getFilesParsed() const {
+		return m_filesParsed;
+	};
+
+	size_t BatchRunner::getScenariosBuilt() const {
+		return m_scenarios.size();
+	};
+
+	void BatchRunner::writeSummary(std::ostream& os, const std::vector<BatchOutcome>& outcomes) {
+		size_t width = 8;
+		for (const auto& outcome : outcomes) {
+			width = std::max(width, outcome.m_name.size());
+		};
+
+		OutputBuffer output(os);
+		output.writeLeft("Scenario", width) << " | Completed | Incomplete | Iterations | Status\n";
+		for (const auto& outcome : outcomes) {
+			output.writeLeft(outcome.m_name, width) << " | ";
+			output.writeRight(outcome.m_result.m_completed, 9) << " | ";
+			output.writeRight(outcome.m_result.m_incomplete, 10) << " | ";
+			output.writeRight(outcome.m_result.m_iterations, 10) << " | ";
+			output << (outcome.m_error.empty() ? "ok" : "error: " + outcome.m_error) << '\n';
+		};
+	};
+}
@@ -0,0 +1,71 @@
+#include "BinaryIO.h"
+
+namespace seneca {
+	void writeBinary(std::ostream& os, uint64_t value) {
+		char bytes[8];
+		for (size_t i = 0; i < 8; i++) {
+			bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+		};
+		os.write(bytes, sizeof(bytes));
+	};
+
+	void writeBinary(std::ostream& os, const std::string& value) {
+		writeBinary(os, static_cast<uint64_t>(value.size()));
+		os.write(value.data(), value.size());
+	};
+
+	uint64_t readBinary(std::istream& is) {
+		unsigned char bytes[8];
+		if (!is.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) throw std::string("Unexpected end of binary data.");
+
+		uint64_t value = 0;
+		for (size_t i = 0; i < 8; i++) {
+			value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+		};
+		return value;
+	};
+
+	std::string readBinaryString(std::istream& is) {
+		uint64_t size = readBinary(is);
+		if (size > (uint64_t(1) << 30)) throw std::string("Corrupt binary data: string too long.");
+		std::string value(size, '\0');
+		if (size > 0 && !is.read(&value[0], size)) throw std::string("Unexpected end of binary data.");
+		return value;
+	};
+
+	void writeVarint(std::ostream& os, uint64_t value) {
+		char bytes[10];
+		size_t size = 0;
+		do {
+			bytes[size] = static_cast<char>(value & 0x7F);
+			value >>= 7;
+			if (value) bytes[size] |= static_cast<char>(0x80);
+			size++;
+		} while (value);
+		os.write(bytes, size);
+	};
+
+	void writeVarintString(std::ostream& os, const std::string& value) {
+		writeVarint(os, value.size());
+		os.write(value.data(), value.size());
+	};
+
+	uint64_t readVarint(std::istream& is) {
+		uint64_t value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			int byte = is.get();
+			if (byte == std::char_traits<char>::eof()) throw std::string("Unexpected end of binary data.");
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return value;
+		};
+		throw std::string("Corrupt binary data: varint too long.");
+	};
+
+	std::string readVarintString(std::istream& is) {
+		uint64_t size = readVarint(is);
+		if (size > (uint64_t(1) << 30)) throw std::string("Corrupt binary data: string too long.");
+		std::string value(size, '\0');
+		if (size > 0 && !is.read(&value[0], size)) throw std::string("Unexpected end of binary data.");
+		return value;
+	};
+}
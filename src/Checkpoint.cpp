@@ -0,0 +1,86 @@
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include "BinaryIO.h"
+#include "Checkpoint.h"
+#include "MemoryTracker.h"
+
+namespace seneca {
+	namespace {
+		const std::string c_magic = "FALSIM-CHECKPOINT";
+		const uint64_t c_version = 2;
+
+		void saveQueue(std::ostream& os, const std::deque<CustomerOrder>& queue) {
+			writeBinary(os, queue.size());
+			for (const auto& order : queue) {
+				order.saveState(os);
+			};
+		}
+
+		void loadQueue(std::istream& is, std::deque<CustomerOrder>& queue) {
+			queue.clear();
+			SENECA_MEMORY_TAG(DequeChunks);
+			for (size_t i = readBinary(is); i > 0; i--) {
+				CustomerOrder order;
+				order.loadState(is);
+				queue.push_back(std::move(order));
+			};
+		}
+	}
+
+	void saveCheckpoint(std::ostream& os, const LineManager& manager, const std::vector<Workstation*>& stations) {
+		writeBinary(os, c_magic);
+		writeBinary(os, c_version);
+		writeBinary(os, Station::getStaticWidthField());
+		writeBinary(os, CustomerOrder::getWidthField());
+		manager.saveState(os);
+
+		writeBinary(os, stations.size());
+		for (const auto* station : stations) {
+			station->saveState(os);
+		};
+
+		saveQueue(os, g_pending);
+		saveQueue(os, g_completed);
+		saveQueue(os, g_incomplete);
+	};
+
+	void restoreCheckpoint(std::istream& is, LineManager& manager, const std::vector<Workstation*>& stations) {
+		if (readBinaryString(is) != c_magic) throw std::string("Not a simulation checkpoint.");
+		if (readBinary(is) != c_version) throw std::string("Unsupported checkpoint version.");
+
+		size_t stationWidth = readBinary(is);
+		size_t orderWidth = readBinary(is);
+		manager.loadState(is);
+
+		if (readBinary(is) != stations.size()) throw std::string("Checkpoint was taken with a different set of stations.");
+		for (auto* station : stations) {
+			station->loadState(is);
+		};
+
+		loadQueue(is, g_pending);
+		loadQueue(is, g_completed);
+		loadQueue(is, g_incomplete);
+
+		Station::setStaticWidthField(stationWidth);
+		CustomerOrder::setWidthField(orderWidth);
+	};
+
+	void saveCheckpoint(const std::string& file, const LineManager& manager, const std::vector<Workstation*>& stations) {
+		std::string temp = file + ".tmp";
+		{
+			std::ofstream ofile(temp, std::ios::binary | std::ios::trunc);
+			if (!ofile) throw std::string("Unable to open ") + temp;
+			saveCheckpoint(ofile, manager, stations);
+			ofile.flush();
+			if (!ofile) throw std::string("Unable to write ") + temp;
+		}
+		if (std::rename(temp.c_str(), file.c_str()) != 0) throw std::string("Unable to replace ") + file;
+	};
+
+	void restoreCheckpoint(const std::string& file, LineManager& manager, const std::vector<Workstation*>& stations) {
+		std::ifstream ifile(file, std::ios::binary);
+		if (!ifile) throw std::string("Unable to open ") + file;
+		restoreCheckpoint(ifile, manager, stations);
+	};
+}
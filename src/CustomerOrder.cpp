@@ -1,7 +1,11 @@
 #include <cstddef>
-#include <iomanip>
 #include <iostream>
+#include "BinaryIO.h"
 #include "CustomerOrder.h"
+#include "LogLevel.h"
+#include "MemoryTracker.h"
+#include "OutputBuffer.h"
+#include "SimulationObserver.h"
 #include "Utilities.h"
 
 namespace seneca {
@@ -10,6 +14,7 @@ namespace seneca {
 	CustomerOrder::CustomerOrder() : m_cntItem(0), m_lstItem(nullptr) {};
 
 	CustomerOrder::CustomerOrder(const std::string& record) {
+		SENECA_MEMORY_TAG(OrderItems);
 		m_cntItem = 0;
 
 		Utilities util;
@@ -53,6 +58,7 @@ namespace seneca {
 		m_product = std::move(src.m_product);
 		m_cntItem = src.m_cntItem;
 		m_lstItem = src.m_lstItem;
+		m_id = src.m_id;
 
 		src.m_lstItem = nullptr;
 		src.m_name = "";
@@ -74,6 +80,7 @@ namespace seneca {
 			m_product = std::move(src.m_product);
 			m_cntItem = src.m_cntItem;
 			m_lstItem = src.m_lstItem;
+			m_id = src.m_id;
 
 			src.m_lstItem = nullptr;
 			src.m_name = "";
@@ -117,36 +124,154 @@ namespace seneca {
 		return isItemFilled;
 	};
 
-	void CustomerOrder::fillItem(Station& station, std::ostream& os) { 
+	void CustomerOrder::fillItem(Station& station, std::ostream& os, SimulationObserver* observer) { 
 		bool filled = false;
 		for (size_t i = 0; i < m_cntItem && !filled; i++) {
 			if (m_lstItem[i]->m_itemName == station.getItemName() && !m_lstItem[i]->m_isFilled) {
-				if (station.getQuantity() > 0) {
-					m_lstItem[i]->m_serialNumber =  station.getNextSerialNumber();		
+				StationReservation unit = station.reserve(1);
+				if (unit.m_count > 0) {
+					m_lstItem[i]->m_serialNumber = unit.m_firstSerial;
 					m_lstItem[i]->m_isFilled = true;
-					station.updateQuantity();
 					filled = true;
 					
-					os << "    Filled " << m_name << ", " << m_product << " " << "[" << m_lstItem[i]->m_itemName << "]" << std::endl; 
+					if (isLogEnabled<LogLevel::Fill>()) os << "    Filled " << m_name << ", " << m_product << " " << "[" << m_lstItem[i]->m_itemName << "]" << std::endl; 
 				} else {
 
-					os << "    Unable to fill " << m_name << ", " << m_product << " " << "[" << m_lstItem[i]->m_itemName << "]" << std::endl; 
+					if (isLogEnabled<LogLevel::Fill>()) os << "    Unable to fill " << m_name << ", " << m_product << " " << "[" << m_lstItem[i]->m_itemName << "]" << std::endl; 
 				};
+				if (observer) observer->onFill(station, *this, i, filled);
 			};
 		};	
 	};
 
+	// Fills one specific item from the station without reporting it
+	bool CustomerOrder::fillItemAt(size_t index, Station& station) {
+		if (m_lstItem[index]->m_isFilled) return false;
+
+		StationReservation unit = station.reserve(1);
+		if (unit.m_count == 0) return false;
+		fillItemAt(index, unit.m_firstSerial);
+		return true;
+	};
+
+	// Fills one item with a serial number already reserved from its station
+	void CustomerOrder::fillItemAt(size_t index, size_t serialNumber) {
+		m_lstItem[index]->m_serialNumber = serialNumber;
+		m_lstItem[index]->m_isFilled = true;
+	};
+
 	void CustomerOrder::display(std::ostream& os) const {
-		os << m_name << " - " << m_product << std::endl;
+		OutputBuffer output(os, 1024);
+		display(output);
+	};
+
+	void CustomerOrder::display(OutputBuffer& output) const {
+		display(output, CustomerOrder::m_widthField);
+	};
+
+	void CustomerOrder::display(OutputBuffer& output, size_t width) const {
+		output << m_name << " - " << m_product << '\n';
 		for (size_t i = 0; i < m_cntItem; i++) {
-			os << std::right << "[" << std::setw(6) << std::setfill('0') << m_lstItem[i]->m_serialNumber << "]" << " ";
-			os<< std::left << std::setw(CustomerOrder::m_widthField) << std::setfill(' ') << m_lstItem[i]->m_itemName << " - ";		
+			output << '[';
+			output.writeRight(m_lstItem[i]->m_serialNumber, 6, '0') << "] ";
+			output.writeLeft(m_lstItem[i]->m_itemName, width) << " - ";
 
 			if(m_lstItem[i]->m_isFilled) {
-				os << "FILLED" << std::endl;
+				output << "FILLED\n";
 			} else {
-				os << "TO BE FILLED" << std::endl;
+				output << "TO BE FILLED\n";
+			};
+		};
+	};
+
+	CustomerOrder CustomerOrder::clone() const {
+		SENECA_MEMORY_TAG(OrderItems);
+		CustomerOrder copy;
+		copy.m_name = m_name;
+		copy.m_product = m_product;
+		copy.m_cntItem = m_cntItem;
+		copy.m_id = m_id;
+
+		if (m_cntItem > 0) {
+			copy.m_lstItem = new Item*[m_cntItem];
+			for (size_t i = 0; i < m_cntItem; i++) {
+				copy.m_lstItem[i] = new Item(*m_lstItem[i]);
+			};
+		};
+		return copy;
+	};
+
+	void CustomerOrder::saveState(std::ostream& os) const {
+		writeBinary(os, m_id);
+		writeBinary(os, m_name);
+		writeBinary(os, m_product);
+		writeBinary(os, m_cntItem);
+		for (size_t i = 0; i < m_cntItem; i++) {
+			writeBinary(os, m_lstItem[i]->m_itemName);
+			writeBinary(os, m_lstItem[i]->m_serialNumber);
+			writeBinary(os, m_lstItem[i]->m_isFilled ? 1 : 0);
+		};
+	};
+
+	void CustomerOrder::loadState(std::istream& is) {
+		SENECA_MEMORY_TAG(OrderItems);
+		CustomerOrder loaded;
+		loaded.m_id = readBinary(is);
+		loaded.m_name = readBinaryString(is);
+		loaded.m_product = readBinaryString(is);
+		size_t cntItem = readBinary(is);
+
+		if (cntItem > 0) {
+			loaded.m_lstItem = new Item*[cntItem]();
+			loaded.m_cntItem = cntItem;
+			for (size_t i = 0; i < cntItem; i++) {
+				loaded.m_lstItem[i] = new Item(readBinaryString(is));
+				loaded.m_lstItem[i]->m_serialNumber = readBinary(is);
+				loaded.m_lstItem[i]->m_isFilled = readBinary(is) != 0;
 			};
 		};
+
+		*this = std::move(loaded);
+	};
+
+	const std::string& CustomerOrder::getName() const {
+		return m_name;
+	};
+
+	const std::string& CustomerOrder::getProduct() const {
+		return m_product;
+	};
+
+	size_t CustomerOrder::getItemCount() const {
+		return m_cntItem;
+	};
+
+	const std::string& CustomerOrder::getItemName(size_t index) const {
+		return m_lstItem[index]->m_itemName;
+	};
+
+	size_t CustomerOrder::getItemSerialNumber(size_t index) const {
+		return m_lstItem[index]->m_serialNumber;
+	};
+
+	bool CustomerOrder::isItemFilledAt(size_t index) const {
+		return m_lstItem[index]->m_isFilled;
+	};
+
+	// Position in which the order entered the line, starting at 1; 0 until admitted
+	size_t CustomerOrder::getId() const {
+		return m_id;
+	};
+
+	void CustomerOrder::setId(size_t id) {
+		m_id = id;
+	};
+
+	size_t CustomerOrder::getWidthField() {
+		return m_widthField;
+	};
+
+	void CustomerOrder::setWidthField(size_t width) {
+		m_widthField = width;
 	};
 }
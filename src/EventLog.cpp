@@ -0,0 +1,322 @@
+#include "BinaryIO.h"
+#include "CustomerOrder.h"
+#include "EventLog.h"
+#include "Workstation.h"
+
+namespace seneca {
+	namespace {
+		const std::string c_magic = "FALSIM-EVENTS";
+		const uint64_t c_version = 2;
+	}
+
+	bool operator==(const LoggedEvent& lhs, const LoggedEvent& rhs) {
+		return lhs.m_type == rhs.m_type && lhs.m_iteration == rhs.m_iteration && lhs.m_station == rhs.m_station
+			&& lhs.m_target == rhs.m_target && lhs.m_order == rhs.m_order && lhs.m_item == rhs.m_item
+			&& lhs.m_serial == rhs.m_serial;
+	};
+
+	bool operator!=(const LoggedEvent& lhs, const LoggedEvent& rhs) {
+		return !(lhs == rhs);
+	};
+
+	EventRecorder::EventRecorder(std::ostream& os, const LineManager& manager) : m_os(os) {
+		writeBinary(m_os, c_magic);
+		writeVarint(m_os, c_version);
+
+		const auto& line = manager.getActiveLine();
+		writeVarint(m_os, line.size());
+		for (size_t i = 0; i < line.size(); i++) {
+			m_stationIndex[line[i]] = i;
+			writeVarintString(m_os, line[i]->getItemName());
+			writeVarint(m_os, line[i]->getSerialNumber());
+			writeVarint(m_os, line[i]->getQuantity());
+		};
+
+		// Pending orders will be numbered in admission order, after those already admitted
+		size_t firstId = manager.getOrderCount() - g_pending.size() + 1;
+		writeVarint(m_os, firstId);
+		writeVarint(m_os, g_pending.size());
+		for (const auto& order : g_pending) {
+			writeVarintString(m_os, order.getName());
+			writeVarintString(m_os, order.getProduct());
+			writeVarint(m_os, order.getItemCount());
+			for (size_t i = 0; i < order.getItemCount(); i++) {
+				writeVarintString(m_os, order.getItemName(i));
+			};
+		};
+		// The item column width of the run's own listings
+		writeVarint(m_os, CustomerOrder::getWidthField());
+	};
+
+	size_t EventRecorder::indexOf(const Station& station) const {
+		auto it = m_stationIndex.find(&station);
+		if (it == m_stationIndex.end()) throw std::string("Event from a station outside the recorded line: ") + station.getItemName();
+		return it->second;
+	};
+
+	// Record layout: type, iteration delta, station, order, then the
+	// type-specific fields
+	void EventRecorder::write(EventType type, size_t station, size_t order, size_t extra1, size_t extra2) {
+		m_os.put(static_cast<char>(type));
+		writeVarint(m_os, m_iteration - m_lastIteration);
+		writeVarint(m_os, station);
+		writeVarint(m_os, order);
+		if (type == EventType::Fill || type == EventType::UnableToFill || type == EventType::Move) writeVarint(m_os, extra1);
+		if (type == EventType::Fill) writeVarint(m_os, extra2);
+		m_lastIteration = m_iteration;
+	};
+
+	void EventRecorder::onIteration(size_t iteration) {
+		m_iteration = iteration;
+	};
+
+	void EventRecorder::onAdmit(const Workstation& station, const CustomerOrder& order) {
+		write(EventType::Admit, indexOf(station), order.getId());
+	};
+
+	void EventRecorder::onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) {
+		if (filled) {
+			write(EventType::Fill, indexOf(station), order.getId(), item, order.getItemSerialNumber(item));
+		} else {
+			write(EventType::UnableToFill, indexOf(station), order.getId(), item);
+		};
+	};
+
+	void EventRecorder::onMove(const Workstation& from, const Workstation& to, const CustomerOrder& order) {
+		write(EventType::Move, indexOf(from), order.getId(), indexOf(to));
+	};
+
+	void EventRecorder::onFinish(const Workstation& station, const CustomerOrder& order, bool completed) {
+		write(completed ? EventType::Complete : EventType::Incomplete, indexOf(station), order.getId());
+	};
+
+	EventLogReader::EventLogReader(std::istream& is) : m_is(is) {
+		if (readBinaryString(m_is) != c_magic) throw std::string("Not a simulation event log.");
+		if (readVarint(m_is) != c_version) throw std::string("Unsupported event log version.");
+
+		m_stations.resize(readVarint(m_is));
+		for (auto& station : m_stations) {
+			station.m_name = readVarintString(m_is);
+			station.m_serialNumber = readVarint(m_is);
+			station.m_quantity = readVarint(m_is);
+		};
+
+		size_t firstId = readVarint(m_is);
+		m_orders.resize(readVarint(m_is));
+		for (size_t i = 0; i < m_orders.size(); i++) {
+			m_orders[i].m_id = firstId + i;
+			m_orders[i].m_name = readVarintString(m_is);
+			m_orders[i].m_product = readVarintString(m_is);
+			m_orders[i].m_items.resize(readVarint(m_is));
+			for (auto& item : m_orders[i].m_items) {
+				item.m_name = readVarintString(m_is);
+			};
+		};
+		m_orderWidth = readVarint(m_is);
+	};
+
+	const std::vector<LoggedStation>& EventLogReader::getStations() const {
+		return m_stations;
+	};
+
+	size_t EventLogReader::getOrderWidth() const {
+		return m_orderWidth;
+	};
+
+	const std::vector<LoggedOrder>& EventLogReader::getOrders() const {
+		return m_orders;
+	};
+
+	bool EventLogReader::next(LoggedEvent& event) {
+		int type = m_is.get();
+		if (type == std::char_traits<char>::eof()) return false;
+		if (type < static_cast<int>(EventType::Admit) || type > static_cast<int>(EventType::Incomplete)) {
+			throw std::string("Corrupt event log: unknown event type.");
+		};
+
+		event = LoggedEvent();
+		event.m_type = static_cast<EventType>(type);
+		m_iteration += readVarint(m_is);
+		event.m_iteration = m_iteration;
+		event.m_station = readVarint(m_is);
+		event.m_order = readVarint(m_is);
+		if (event.m_type == EventType::Fill || event.m_type == EventType::UnableToFill) event.m_item = readVarint(m_is);
+		if (event.m_type == EventType::Move) event.m_target = readVarint(m_is);
+		if (event.m_type == EventType::Fill) event.m_serial = readVarint(m_is);
+
+		if (event.m_station >= m_stations.size() || (event.m_type == EventType::Move && event.m_target >= m_stations.size())) {
+			throw std::string("Corrupt event log: unknown station.");
+		};
+		return true;
+	};
+
+	// One line per event in the same words the simulator prints
+	std::string EventLogReader::describe(const LoggedEvent& event) const {
+		std::string order = "#" + std::to_string(event.m_order);
+		std::string item;
+		if (!m_orders.empty() && event.m_order >= m_orders.front().m_id && event.m_order - m_orders.front().m_id < m_orders.size()) {
+			const LoggedOrder& logged = m_orders[event.m_order - m_orders.front().m_id];
+			order = logged.m_name + ", " + logged.m_product;
+			if (event.m_item < logged.m_items.size()) item = logged.m_items[event.m_item].m_name;
+		};
+
+		std::string text = std::to_string(event.m_iteration) + ": ";
+		const std::string& station = m_stations[event.m_station].m_name;
+		switch (event.m_type) {
+		case EventType::Admit:
+			text += "Admitted " + order + " at " + station;
+			break;
+		case EventType::Fill:
+			text += "Filled " + order + " [" + item + "] serial " + std::to_string(event.m_serial);
+			break;
+		case EventType::UnableToFill:
+			text += "Unable to fill " + order + " [" + item + "]";
+			break;
+		case EventType::Move:
+			text += "Moved " + order + " from " + station + " to " + m_stations[event.m_target].m_name;
+			break;
+		case EventType::Complete:
+			text += "Completed " + order + " at " + station;
+			break;
+		case EventType::Incomplete:
+			text += "Incomplete " + order + " at " + station;
+			break;
+		};
+		return text;
+	};
+
+	ReplayState::ReplayState(const EventLogReader& reader) : m_stations(reader.getStations()), m_queues(reader.getStations().size()), m_orders(reader.getOrders()), m_orderWidth(reader.getOrderWidth()) {
+		m_firstId = m_orders.empty() ? 0 : m_orders.front().m_id;
+		for (const auto& order : m_orders) {
+			m_pending.push_back(order.m_id);
+		};
+	};
+
+	size_t ReplayState::slot(size_t id) const {
+		if (id < m_firstId || id - m_firstId >= m_orders.size()) throw std::string("Corrupt event log: unknown order.");
+		return id - m_firstId;
+	};
+
+	void ReplayState::apply(const LoggedEvent& event) {
+		auto takeFront = [&](std::deque<size_t>& queue) {
+			if (queue.empty() || queue.front() != event.m_order) throw std::string("Corrupt event log: order is not at the front of its queue.");
+			queue.pop_front();
+		};
+
+		m_iteration = event.m_iteration;
+		LoggedStation& station = m_stations[event.m_station];
+		switch (event.m_type) {
+		case EventType::Admit:
+			takeFront(m_pending);
+			m_queues[event.m_station].push_back(event.m_order);
+			break;
+		case EventType::Fill: {
+			LoggedOrder& filled = m_orders[slot(event.m_order)];
+			if (event.m_item >= filled.m_items.size()) throw std::string("Corrupt event log: unknown item.");
+			filled.m_items[event.m_item].m_serialNumber = event.m_serial;
+			filled.m_items[event.m_item].m_isFilled = true;
+			station.m_serialNumber = event.m_serial + 1;
+			if (station.m_quantity > 0) station.m_quantity--;
+			break;
+		}
+		case EventType::UnableToFill:
+			break;
+		case EventType::Move:
+			takeFront(m_queues[event.m_station]);
+			m_queues[event.m_target].push_back(event.m_order);
+			break;
+		case EventType::Complete:
+			takeFront(m_queues[event.m_station]);
+			m_completed.push_back(event.m_order);
+			break;
+		case EventType::Incomplete:
+			takeFront(m_queues[event.m_station]);
+			m_incomplete.push_back(event.m_order);
+			break;
+		};
+	};
+
+	size_t ReplayState::getIteration() const {
+		return m_iteration;
+	};
+
+	const std::vector<LoggedStation>& ReplayState::getStations() const {
+		return m_stations;
+	};
+
+	const std::deque<size_t>& ReplayState::getQueue(size_t station) const {
+		return m_queues[station];
+	};
+
+	const std::deque<size_t>& ReplayState::getPending() const {
+		return m_pending;
+	};
+
+	const std::deque<size_t>& ReplayState::getCompleted() const {
+		return m_completed;
+	};
+
+	const std::deque<size_t>& ReplayState::getIncomplete() const {
+		return m_incomplete;
+	};
+
+	const LoggedOrder& ReplayState::getOrder(size_t id) const {
+		return m_orders[slot(id)];
+	};
+
+	// Same layout as CustomerOrder::display, at the width the recorded run used
+	void ReplayState::displayOrders(OutputBuffer& output, const std::deque<size_t>& ids) const {
+		for (size_t id : ids) {
+			const LoggedOrder& order = getOrder(id);
+			output << order.m_name << " - " << order.m_product << '\n';
+			for (const auto& item : order.m_items) {
+				output << '[';
+				output.writeRight(item.m_serialNumber, 6, '0') << "] ";
+				output.writeLeft(item.m_name, m_orderWidth) << " - ";
+				output << (item.m_isFilled ? "FILLED\n" : "TO BE FILLED\n");
+			};
+		};
+	};
+
+	void ReplayState::display(std::ostream& os) const {
+		OutputBuffer output(os);
+		output << "State after iteration " << m_iteration << '\n';
+
+		output << "\nPending Orders: " << m_pending.size() << '\n';
+		output << "\nStation Queues:\n";
+		for (size_t i = 0; i < m_stations.size(); i++) {
+			output << m_stations[i].m_name << ':';
+			for (size_t id : m_queues[i]) {
+				output << " [" << getOrder(id).m_name << ']';
+			};
+			output << '\n';
+		};
+
+		output << "\nCompleted Orders:\n";
+		displayOrders(output, m_completed);
+		output << "\nIncomplete Orders:\n";
+		displayOrders(output, m_incomplete);
+
+		output << "\nRemaining Inventory:\n";
+		for (const auto& station : m_stations) {
+			output << station.m_name << " | ";
+			output.writeRight(station.m_serialNumber, 6, '0') << " | ";
+			output.writeRight(station.m_quantity, 4) << '\n';
+		};
+	};
+
+	ReplayState ReplayState::replay(std::istream& is, size_t iteration) {
+		EventLogReader reader(is);
+		ReplayState state(reader);
+
+		LoggedEvent event;
+		while (reader.next(event)) {
+			if (event.m_iteration > iteration) {
+				state.m_iteration = iteration;
+				break;
+			};
+			state.apply(event);
+		};
+		return state;
+	};
+}
@@ -0,0 +1,21 @@
+#include "FactoryCore.h"
+
+#ifndef FACTORY_CORE_VERSION
+#define FACTORY_CORE_VERSION "unknown"
+#endif
+
+namespace seneca {
+	const char* getFactoryCoreVersion() {
+		return FACTORY_CORE_VERSION;
+	};
+
+	Scenario loadScenario(const std::string& stations1, const std::string& stations2,
+		const std::string& orders, const std::string& line) {
+		Scenario scenario;
+		scenario.loadStations(stations1, ',');
+		scenario.loadStations(stations2, '|');
+		scenario.loadOrders(orders, '|');
+		scenario.loadLine(line);
+		return scenario;
+	};
+}
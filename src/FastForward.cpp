@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include "FastForward.h"
+#include "MemoryTracker.h"
+
+namespace seneca {
+	namespace {
+		// Stations per item an order must pass, on average, before keeping the
+		// departure times as steps beats rewriting them all per order
+		const size_t c_steppedStationsPerItem = 512;
+
+		// When each station last let an order go, less the number of orders
+		// admitted so far. Every order passes every station, so the offset
+		// turns "one iteration later than the order before it" into no change
+		// at all. An order can then leave the stations it fills nothing from
+		// untouched, except where it arrives later than the order before it.
+		// Departures never fall along the line, so that is a raise of a
+		// prefix of the run.
+		class DenseDepartures {
+			std::vector<size_t> m_times;
+		public:
+			DenseDepartures(size_t stations) : m_times(stations, 0) {};
+			size_t at(size_t station) const {
+				return m_times[station];
+			};
+			void set(size_t station, size_t time) {
+				m_times[station] = time;
+			};
+			// Every station in [first, last] departs no earlier than `time`
+			void raise(size_t first, size_t last, size_t time) {
+				for (size_t s = first; s <= last; s++) {
+					m_times[s] = std::max(m_times[s], time);
+				};
+			};
+		};
+
+		// The same times as runs of equal values, keyed by the first station of
+		// each run. A raise merges the runs it covers into one, so each run is
+		// erased at most once and every operation is amortized O(log stations).
+		class SteppedDepartures {
+			std::map<size_t, size_t> m_steps;
+			size_t m_stations;
+			void split(size_t station) {
+				if (station >= m_stations) return;
+				auto it = std::prev(m_steps.upper_bound(station));
+				if (it->first != station) m_steps.emplace_hint(std::next(it), station, it->second);
+			};
+		public:
+			SteppedDepartures(size_t stations) : m_stations(stations) {
+				m_steps.emplace(0, 0);
+			};
+			size_t at(size_t station) const {
+				return std::prev(m_steps.upper_bound(station))->second;
+			};
+			void set(size_t station, size_t time) {
+				split(station);
+				split(station + 1);
+				m_steps[station] = time;
+			};
+			void raise(size_t first, size_t last, size_t time) {
+				if (at(first) >= time) return;
+				split(first);
+				split(last + 1);
+				auto it = m_steps.find(first);
+				while (it != m_steps.end() && it->first <= last && it->second < time) {
+					it = m_steps.erase(it);
+				};
+				m_steps.emplace_hint(it, first, time);
+			};
+		};
+
+		// Moves the order numbered `admitted` through the line, given the
+		// stations it fills from (ascending, one entry per item), and returns
+		// the iteration it leaves the last station in. An order joins the first
+		// station before that iteration's fills and every later station during
+		// the move pass, which visits stations in line order. It fills one item
+		// per iteration once at the front and leaves in the move pass of its
+		// last fill; with nothing to fill it leaves in the first move pass it
+		// spends at the front. Departures are stored less `admitted`, and read
+		// back less the `admitted - 1` of the order before.
+		template <typename Departures>
+		size_t depart(Departures& departures, size_t stations, const std::vector<size_t>& filledAt, size_t admitted) {
+			size_t tick = admitted;
+			size_t next = 0;
+			for (size_t i = 0; i < filledAt.size();) {
+				size_t station = filledAt[i];
+				size_t fills = 0;
+				for (; i < filledAt.size() && filledAt[i] == station; i++) fills++;
+
+				// Stations passed without a fill hold the order only behind the one before
+				if (next < station) {
+					departures.raise(next, station - 1, tick - admitted);
+					tick = departures.at(station - 1) + admitted;
+				};
+
+				size_t departed = departures.at(station) + admitted - 1;
+				if (departed >= tick) {
+					tick = departed + fills;
+				} else {
+					tick = station == 0 ? tick + fills - 1 : tick + fills;
+				};
+				departures.set(station, tick - admitted);
+				next = station + 1;
+			};
+			if (next < stations) {
+				departures.raise(next, stations - 1, tick - admitted);
+				tick = departures.at(stations - 1) + admitted;
+			};
+			return tick;
+		};
+
+		template <typename Departures>
+		size_t fastForward(const std::vector<Workstation*>& line, ResultSink* sink, Departures departures) {
+			// Stations that stock each item, in the order an order reaches them
+			std::unordered_map<std::string, std::vector<size_t>> stationsByItem;
+			for (size_t i = 0; i < line.size(); i++) {
+				stationsByItem[line[i]->getItemName()].push_back(i);
+			};
+
+			std::vector<size_t> filledAt;
+			size_t admitted = 0;
+			size_t iterations = 1;
+
+			while (!g_pending.empty()) {
+				CustomerOrder order = std::move(g_pending.front());
+				g_pending.pop_front();
+				order.setId(++admitted);
+
+				filledAt.clear();
+				for (size_t i = 0; i < order.getItemCount(); i++) {
+					auto stations = stationsByItem.find(order.getItemName(i));
+					if (stations == stationsByItem.end()) continue;
+
+					for (size_t station : stations->second) {
+						if (order.fillItemAt(i, *line[station])) {
+							filledAt.push_back(station);
+							break;
+						};
+					};
+				};
+				std::sort(filledAt.begin(), filledAt.end());
+				iterations = depart(departures, line.size(), filledAt, admitted);
+
+				if (sink) {
+					bool completed = order.isOrderFilled();
+					sink->accept(std::move(order), completed);
+					continue;
+				};
+				SENECA_MEMORY_TAG(DequeChunks);
+				if (order.isOrderFilled()) {
+					g_completed.push_back(std::move(order));
+				} else {
+					g_incomplete.push_back(std::move(order));
+				};
+			};
+
+			return iterations;
+		};
+	}
+
+	size_t fastForward(const std::vector<Workstation*>& line, ResultSink* sink) {
+		if (line.empty() && !g_pending.empty()) throw std::string("Cannot run orders without an assembly line.");
+		size_t items = 0;
+		for (const auto& order : g_pending) {
+			items += order.getItemCount() + 1;
+		};
+		if (line.size() * g_pending.size() > c_steppedStationsPerItem * items) return fastForward(line, sink, SteppedDepartures(line.size()));
+		return fastForward(line, sink, DenseDepartures(line.size()));
+	};
+}
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "ScenarioGenerator.h"
+
+using namespace seneca;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " <output directory> [options]\n"
+                  << "  --items <n>              item types, one station each (default 10)\n"
+                  << "  --orders <n>             customer orders (default 1000)\n"
+                  << "  --items-per-order <a:b>  items per order, uniform in [a, b] (default 1:5)\n"
+                  << "  --zipf <s>               popularity skew, 0 for uniform (default 0)\n"
+                  << "  --stock <f>              stock as a fraction of expected demand (default 1.0)\n"
+                  << "  --line <n>               stations in the assembly line (default all)\n"
+                  << "  --delimiter <split|comma|pipe>\n"
+                  << "                           split: half the stations in each file, as batch mode\n"
+                  << "                           expects; otherwise all in Stations1.txt (default split)\n"
+                  << "  --seed <n>               random seed (default 1)\n";
+    }
+
+    std::ofstream openOutput(const std::filesystem::path& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::string("Unable to open ") + path.string();
+        }
+        return file;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]).rfind("--", 0) == 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    GeneratorSpec spec;
+    std::string delimiter = "split";
+    try {
+        for (int i = 2; i < argc; i += 2) {
+            std::string option = argv[i];
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            std::string value = argv[i + 1];
+
+            if (option == "--items") {
+                spec.m_itemTypes = std::stoul(value);
+            }
+            else if (option == "--orders") {
+                spec.m_orders = std::stoul(value);
+            }
+            else if (option == "--items-per-order") {
+                size_t colon = value.find(':');
+                spec.m_minItems = std::stoul(value.substr(0, colon));
+                spec.m_maxItems = colon == std::string::npos ? spec.m_minItems : std::stoul(value.substr(colon + 1));
+            }
+            else if (option == "--zipf") {
+                spec.m_zipf = std::stod(value);
+            }
+            else if (option == "--stock") {
+                spec.m_stock = std::stod(value);
+            }
+            else if (option == "--line") {
+                spec.m_lineLength = std::stoul(value);
+            }
+            else if (option == "--delimiter" && (value == "split" || value == "comma" || value == "pipe")) {
+                delimiter = value;
+            }
+            else if (option == "--seed") {
+                spec.m_seed = std::stoull(value);
+            }
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch (const std::logic_error&) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        auto started = std::chrono::steady_clock::now();
+        ScenarioGenerator generator(spec);
+        std::filesystem::path directory(argv[1]);
+        std::filesystem::create_directories(directory);
+
+        size_t items = generator.getItems().size();
+        size_t split = delimiter == "split" ? (items + 1) / 2 : items;
+        {
+            std::ofstream stations1 = openOutput(directory / "Stations1.txt");
+            generator.writeStations(stations1, 0, split, delimiter == "pipe" ? '|' : ',');
+            std::ofstream stations2 = openOutput(directory / "Stations2.txt");
+            generator.writeStations(stations2, split, items, '|');
+            std::ofstream line = openOutput(directory / "AssemblyLine.txt");
+            generator.writeLine(line);
+            std::ofstream orders = openOutput(directory / "CustomerOrders.txt");
+            generator.writeOrders(orders);
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        uintmax_t bytes = 0;
+        for (const char* name : {"Stations1.txt", "Stations2.txt", "AssemblyLine.txt", "CustomerOrders.txt"}) {
+            bytes += std::filesystem::file_size(directory / name);
+        }
+        std::cout << "Wrote " << items << " stations, " << spec.m_orders << " orders and a "
+                  << generator.getLine().size() << "-station line to " << directory.string()
+                  << " (" << bytes << " bytes in " << seconds << " s)\n";
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    catch (const std::filesystem::filesystem_error& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
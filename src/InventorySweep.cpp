@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <stdexcept>
+#include "InventorySweep.h"
+#include "OutputBuffer.h"
+#include "Parallel.h"
+
+namespace seneca {
+	namespace {
+		// Points one range axis may expand to, and a whole sweep may run
+		const size_t c_maxAxisPoints = 100000;
+		const size_t c_maxSweepPoints = 1000000;
+	}
+
+	InventorySweep::InventorySweep(const Scenario& scenario, size_t workers) : m_scenario(scenario), m_workers(workers) {};
+
+	void InventorySweep::setFastForward(bool fastForward) {
+		m_fastForward = fastForward;
+	};
+
+	void InventorySweep::addAxis(const SweepAxis& axis) {
+		if (!m_scenario.findStation(axis.m_station)) throw std::string("Unknown station in sweep: ") + axis.m_station;
+		if (axis.m_quantities.empty()) throw std::string("Sweep axis has no quantities: ") + axis.m_station;
+		// Divides rather than multiplies, so the check itself cannot wrap
+		size_t points = m_axes.empty() ? 1 : getPointCount();
+		if (axis.m_quantities.size() > c_maxSweepPoints / points) {
+			throw std::string("Sweep has too many points (limit ") + std::to_string(c_maxSweepPoints) + ") with axis " + axis.m_station;
+		};
+		m_axes.push_back(axis);
+	};
+
+	// addAxis keeps the product within c_maxSweepPoints
+	size_t InventorySweep::getPointCount() const {
+		size_t count = m_axes.empty() ? 0 : 1;
+		for (const auto& axis : m_axes) {
+			count *= axis.m_quantities.size();
+		};
+		return count;
+	};
+
+	// Decodes a point index into one quantity per axis, last axis varying fastest
+	InventoryOverlay InventorySweep::getOverlay(size_t point) const {
+		InventoryOverlay overlay;
+		for (size_t i = m_axes.size(); i-- > 0;) {
+			const auto& quantities = m_axes[i].m_quantities;
+			overlay[m_axes[i].m_station] = quantities[point % quantities.size()];
+			point /= quantities.size();
+		};
+		return overlay;
+	};
+
+	std::vector<SweepPoint> InventorySweep::run() const {
+		std::vector<SweepPoint> points(getPointCount());
+
+		parallelFor(points.size(), m_workers, [&](size_t i) {
+			InventoryOverlay overlay = getOverlay(i);
+			for (const auto& axis : m_axes) {
+				points[i].m_quantities.push_back(overlay[axis.m_station]);
+			};
+
+			std::ostream quiet(nullptr);
+			SimulationContext context(m_scenario, overlay);
+			points[i].m_result = m_fastForward ? context.fastForward() : context.run(quiet);
+		});
+
+		return points;
+	};
+
+	void InventorySweep::writeTable(std::ostream& os, const std::vector<SweepPoint>& points) const {
+		const std::vector<std::string> counters = { "Completed", "Incomplete", "Iterations" };
+		std::vector<size_t> widths;
+		OutputBuffer output(os);
+
+		// Station names are right justified over their column
+		for (const auto& axis : m_axes) {
+			widths.push_back(std::max<size_t>(axis.m_station.size(), 4));
+			output.pad(widths.back() - axis.m_station.size()) << axis.m_station << " | ";
+		};
+		for (size_t i = 0; i < counters.size(); i++) {
+			output << counters[i] << (i + 1 < counters.size() ? " | " : "");
+		};
+		output << '\n';
+
+		for (const auto& point : points) {
+			for (size_t i = 0; i < m_axes.size(); i++) {
+				output.writeRight(point.m_quantities[i], widths[i]) << " | ";
+			};
+			output.writeRight(point.m_result.m_completed, counters[0].size()) << " | ";
+			output.writeRight(point.m_result.m_incomplete, counters[1].size()) << " | ";
+			output.writeRight(point.m_result.m_iterations, counters[2].size()) << '\n';
+		};
+	};
+
+	// Accepts "Name=a:b" (a through b), "Name=a:b:step" or "Name=q1,q2,q3"
+	SweepAxis InventorySweep::parseAxis(const std::string& spec) {
+		size_t equals = spec.find('=');
+		if (equals == std::string::npos || equals == 0 || equals + 1 == spec.size()) {
+			throw std::string("Invalid sweep axis: ") + spec;
+		};
+
+		SweepAxis axis;
+		axis.m_station = spec.substr(0, equals);
+		std::string values = spec.substr(equals + 1);
+
+		try {
+			if (values.find(':') != std::string::npos) {
+				size_t first = values.find(':');
+				size_t second = values.find(':', first + 1);
+				size_t from = std::stoul(values.substr(0, first));
+				size_t to = std::stoul(values.substr(first + 1, second == std::string::npos ? std::string::npos : second - first - 1));
+				size_t step = second == std::string::npos ? 1 : std::stoul(values.substr(second + 1));
+				if (step == 0 || to < from) throw std::string("Invalid sweep range: ") + spec;
+				if ((to - from) / step >= c_maxAxisPoints) throw std::string("Sweep range has too many points: ") + spec;
+
+				// Stop before `quantity += step` could pass `to` and wrap around
+				for (size_t quantity = from; ; quantity += step) {
+					axis.m_quantities.push_back(quantity);
+					if (to - quantity < step) break;
+				};
+			} else {
+				size_t start = 0;
+				while (start <= values.size()) {
+					size_t comma = values.find(',', start);
+					if (comma == std::string::npos) comma = values.size();
+					axis.m_quantities.push_back(std::stoul(values.substr(start, comma - start)));
+					start = comma + 1;
+				};
+			};
+		} catch (const std::logic_error&) {
+			throw std::string("Invalid sweep axis: ") + spec;
+		};
+
+		return axis;
+	};
+}
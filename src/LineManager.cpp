@@ -3,12 +3,17 @@
 #include <algorithm>
 #include <utility>
 #include <vector>
+#include "BinaryIO.h"
 #include "LineManager.h"
+#include "LogLevel.h"
+#include "OutputBuffer.h"
+#include "Profiler.h"
 #include "Utilities.h"
 #include "Workstation.h"
 
 namespace seneca {
 	LineManager::LineManager(const std::string& file, const std::vector<Workstation*>& stations) {
+		SENECA_PROFILE_ZONE("line.construct");
 		std::ifstream ifile(file);
 		if(!ifile.is_open()) throw std::string("Can't throw file.") + file;
 
@@ -76,7 +81,20 @@ namespace seneca {
 		m_cntCustomerOrder = g_pending.size();	
 	};	
 
+	// Builds a line that visits the given stations in sequence, last one ending the line
+	LineManager::LineManager(const std::vector<Workstation*>& line) : m_activeLine(line) {
+		SENECA_PROFILE_ZONE("line.construct");
+		m_firstStation = m_activeLine.empty() ? nullptr : m_activeLine.front();
+
+		for (size_t i = 0; i < m_activeLine.size(); i++) {
+			m_activeLine[i]->setNextStation(i + 1 < m_activeLine.size() ? m_activeLine[i + 1] : nullptr);
+		};
+
+		m_cntCustomerOrder = g_pending.size();
+	};
+
 	void LineManager::reorderStations() {
+		SENECA_PROFILE_ZONE("line.reorder");
 		std::vector<Workstation*> orderedStation;
 		Workstation* current = m_firstStation;
 
@@ -86,46 +104,104 @@ namespace seneca {
 		}
 		
 		m_activeLine = std::move(orderedStation);
+		setObserver(m_observer);
+		setResultSink(m_sink);
 	};
 
 	bool LineManager::run(std::ostream& os) {
-		static size_t iteration = 0;
-
-		os << "Line Manager Iteration: " << ++iteration << std::endl;	
+		SENECA_PROFILE_ZONE("run");
+		++m_iteration;
+		if (isLogEnabled<LogLevel::Iteration>()) os << "Line Manager Iteration: " << m_iteration << std::endl;
+		if (m_observer) m_observer->onIteration(m_iteration);
 
 		if (!g_pending.empty()) {
+			SENECA_PROFILE_ZONE("run.admit");
+			SENECA_PROFILE_COUNT("orders.admitted", 1);
+			// Orders are numbered in the sequence they enter the line
+			g_pending.front().setId(m_cntCustomerOrder - g_pending.size() + 1);
+			if (m_observer) m_observer->onAdmit(*m_firstStation, g_pending.front());
+
 			(*m_firstStation) += std::move(g_pending.front());
 			g_pending.pop_front();
 
 		}; 
 		
-		std::for_each(m_activeLine.begin(), m_activeLine.end(), 
-			[&](Workstation* station) {
-				station->fill(os);
-			});
+		{
+			SENECA_PROFILE_ZONE("run.fill");
+			std::for_each(m_activeLine.begin(), m_activeLine.end(), 
+				[&](Workstation* station) {
+					station->fill(os);
+				});
+		}
 		
-		std::for_each(m_activeLine.begin(), m_activeLine.end(), 
-			[](Workstation* station) {
-				station->attemptToMoveOrder();				
-			});
+		{
+			SENECA_PROFILE_ZONE("run.move");
+			std::for_each(m_activeLine.begin(), m_activeLine.end(), 
+				[](Workstation* station) {
+					station->attemptToMoveOrder();				
+				});
+		}
+
+		if (m_observer) m_observer->onIterationEnd(m_iteration);
 
-		return g_completed.size() + g_incomplete.size() == m_cntCustomerOrder;
+		size_t finished = g_completed.size() + g_incomplete.size();
+		if (m_sink) finished += m_sink->getCompletedCount() + m_sink->getIncompleteCount();
+		return finished == m_cntCustomerOrder;
 	};
 
 	void LineManager::display(std::ostream& os) const {
+		OutputBuffer output(os);
 		std::for_each(m_activeLine.begin(), m_activeLine.end(), 
-		[&os](Workstation* station){
+		[&output](Workstation* station){
 			
-			std::string nextStationName;
 			Workstation* nextStationPtr = station->getNextStation();	
 
+			output << station->getItemName() << " --> ";
 			if (nextStationPtr) {
-				nextStationName = nextStationPtr->getItemName(); 
+				output << nextStationPtr->getItemName(); 
 			} else {
-				nextStationName = "End of Line";
+				output << "End of Line";
 			};
-			
-			os << station->getItemName() << " --> " << nextStationName << std::endl;
+			output << '\n';
 		});
 	};
+
+	const std::vector<Workstation*>& LineManager::getActiveLine() const {
+		return m_activeLine;
+	};
+
+	size_t LineManager::getIterationCount() const {
+		return m_iteration;
+	};
+
+	// Orders this line will process, counting those already finished
+	size_t LineManager::getOrderCount() const {
+		return m_cntCustomerOrder;
+	};
+
+	// Attaches the observer to the line and its active stations; nullptr detaches
+	void LineManager::setObserver(SimulationObserver* observer) {
+		m_observer = observer;
+		for (auto* station : m_activeLine) {
+			station->setObserver(observer);
+		};
+	};
+
+	// Sends orders leaving the line to the sink; nullptr keeps them in g_completed/g_incomplete
+	void LineManager::setResultSink(ResultSink* sink) {
+		m_sink = sink;
+		for (auto* station : m_activeLine) {
+			station->setResultSink(sink);
+		};
+	};
+
+	void LineManager::saveState(std::ostream& os) const {
+		writeBinary(os, m_iteration);
+		writeBinary(os, m_cntCustomerOrder);
+	};
+
+	void LineManager::loadState(std::istream& is) {
+		m_iteration = readBinary(is);
+		m_cntCustomerOrder = readBinary(is);
+	};
 }
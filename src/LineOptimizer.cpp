@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include "LineOptimizer.h"
+#include "Parallel.h"
+#include "SimulationContext.h"
+
+namespace seneca {
+	LineOptimizer::LineOptimizer(const Scenario& scenario, const OptimizerOptions& options) : m_scenario(scenario), m_options(options) {};
+
+	std::string LineOptimizer::makeKey(const std::vector<std::string>& line) {
+		std::string key;
+		for (const auto& name : line) {
+			key += name;
+			key += '\n';
+		};
+		return key;
+	};
+
+	bool LineOptimizer::isBetter(const LineFitness& lhs, const LineFitness& rhs) {
+		if (lhs.m_completed != rhs.m_completed) return lhs.m_completed > rhs.m_completed;
+		return lhs.m_iterations < rhs.m_iterations;
+	};
+
+	// Simulates every candidate that is not memoized yet. Results are collected
+	// per index and merged afterwards, so the workers never touch the memo and
+	// a candidate that throws leaves nothing behind in it.
+	void LineOptimizer::evaluate(const std::vector<std::vector<std::string>>& candidates) {
+		std::set<std::string> keys;
+		std::vector<const std::vector<std::string>*> pending;
+		for (const auto& line : candidates) {
+			std::string key = makeKey(line);
+			if (m_memo.find(key) == m_memo.end() && keys.insert(key).second) {
+				pending.push_back(&line);
+			};
+		};
+
+		std::vector<LineFitness> results(pending.size());
+		parallelFor(pending.size(), m_options.m_workers, [&](size_t i) {
+			std::ostream quiet(nullptr);
+			SimulationContext context(m_scenario, *pending[i]);
+			SimulationResult result = m_options.m_fastForward ? context.fastForward() : context.run(quiet);
+			results[i].m_completed = result.m_completed;
+			results[i].m_iterations = result.m_iterations;
+		});
+
+		for (size_t i = 0; i < pending.size(); i++) {
+			m_memo[makeKey(*pending[i])] = results[i];
+		};
+	};
+
+	LineFitness LineOptimizer::getFitness(const std::vector<std::string>& line) {
+		evaluate({ line });
+		return m_memo[makeKey(line)];
+	};
+
+	std::vector<std::string> LineOptimizer::search(std::vector<std::string> line) {
+		LineFitness best = getFitness(line);
+
+		for (size_t round = 0; round < m_options.m_maxRounds; round++) {
+			std::vector<std::vector<std::string>> neighbours;
+			for (size_t i = 0; i < line.size(); i++) {
+				for (size_t j = i + 1; j < line.size(); j++) {
+					neighbours.push_back(line);
+					std::swap(neighbours.back()[i], neighbours.back()[j]);
+				};
+			};
+			evaluate(neighbours);
+
+			const std::vector<std::string>* bestNeighbour = nullptr;
+			for (const auto& candidate : neighbours) {
+				const LineFitness& fitness = m_memo[makeKey(candidate)];
+				if (isBetter(fitness, best)) {
+					best = fitness;
+					bestNeighbour = &candidate;
+				};
+			};
+
+			if (!bestNeighbour) break;
+			line = *bestNeighbour;
+		};
+
+		return line;
+	};
+
+	std::vector<std::string> LineOptimizer::optimize() {
+		std::vector<std::string> best = search(m_scenario.getLine());
+		std::mt19937 random(m_options.m_seed);
+
+		for (size_t restart = 0; restart < m_options.m_restarts; restart++) {
+			std::vector<std::string> start = m_scenario.getLine();
+			std::shuffle(start.begin(), start.end(), random);
+
+			std::vector<std::string> candidate = search(start);
+			if (isBetter(getFitness(candidate), getFitness(best))) best = candidate;
+		};
+
+		return best;
+	};
+
+	size_t LineOptimizer::getEvaluationCount() const {
+		return m_memo.size();
+	};
+
+	// Writes the line in AssemblyLine.txt form: one "Station|Next" pair per line
+	void LineOptimizer::writeLine(std::ostream& os, const std::vector<std::string>& line) {
+		for (size_t i = 0; i < line.size(); i++) {
+			os << line[i];
+			if (i + 1 < line.size()) os << '|' << line[i + 1];
+			os << std::endl;
+		};
+	};
+}
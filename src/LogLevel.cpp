@@ -0,0 +1,24 @@
+#include <atomic>
+#include "LogLevel.h"
+
+namespace seneca {
+	namespace {
+		std::atomic<LogLevel> g_logLevel{maxLogLevel};
+	}
+
+	LogLevel getLogLevel() {
+		return g_logLevel.load(std::memory_order_relaxed);
+	};
+
+	void setLogLevel(LogLevel level) {
+		g_logLevel.store(level, std::memory_order_relaxed);
+	};
+
+	LogLevel parseLogLevel(const std::string& name) {
+		if (name == "off") return LogLevel::Off;
+		if (name == "summary") return LogLevel::Summary;
+		if (name == "iteration") return LogLevel::Iteration;
+		if (name == "fill") return LogLevel::Fill;
+		throw std::string("Unknown log level: ") + name;
+	};
+}
@@ -3,11 +3,35 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <csignal>
+#include <memory>
+#include <stdexcept>
 #include "Station.h"
 #include "Workstation.h"
 #include "CustomerOrder.h"
 #include "Utilities.h"
 #include "LineManager.h"
+#include "BatchRunner.h"
+#include "Checkpoint.h"
+#include "EventLog.h"
+#include "FactoryCore.h"
+#include "FastForward.h"
+#include "InventorySweep.h"
+#include "LineOptimizer.h"
+#include "Scenario.h"
+#include "SharedInventory.h"
+#include "SimulationServer.h"
+#include "AsyncLogger.h"
+#include "LogLevel.h"
+#include "MemoryTracker.h"
+#include "OutputBuffer.h"
+#include "Metrics.h"
+#include "PerfCounters.h"
+#include "PolicyEngine.h"
+#include "Profiler.h"
+#include "ReportWriter.h"
+#include "ResultSink.h"
+#include "TraceExporter.h"
 
 using namespace seneca;
 
@@ -28,7 +52,312 @@ void displayMenu() {
     std::cout << "Enter your choice: ";
 }
 
+// Options that may precede the four batch-mode files
+struct BatchOptions {
+    std::string checkpointFile;
+    size_t checkpointEvery = 0;
+    size_t stopAt = 0;
+    std::string resumeFile;
+    std::string recordFile;
+    std::string traceFile;
+    std::string reportFile;
+    std::string spillFile;
+    bool fastForward = false;
+    bool metrics = false;
+    bool perf = false;
+};
+
+// Set by SIGINT/SIGTERM so a batch run can checkpoint before exiting
+volatile std::sig_atomic_t g_stopRequested = 0;
+
+void requestStop(int) {
+    g_stopRequested = 1;
+}
+
+// Returns the index of the first file argument, or -1 if an option is malformed
+int parseBatchOptions(int argc, char* argv[], BatchOptions& options) {
+    int i = 1;
+    try {
+        while (i < argc && std::string(argv[i]).rfind("--", 0) == 0) {
+            std::string option = argv[i];
+            if (option == "--fast-forward" || option == "--metrics" || option == "--perf") {
+                (option == "--metrics" ? options.metrics : option == "--perf" ? options.perf : options.fastForward) = true;
+                i++;
+                continue;
+            }
+            if (i + 1 >= argc) return -1;
+
+            if (option == "--checkpoint") {
+                options.checkpointFile = argv[i + 1];
+            }
+            else if (option == "--checkpoint-every") {
+                options.checkpointEvery = std::stoul(argv[i + 1]);
+            }
+            else if (option == "--stop-at") {
+                options.stopAt = std::stoul(argv[i + 1]);
+            }
+            else if (option == "--resume") {
+                options.resumeFile = argv[i + 1];
+            }
+            else if (option == "--record") {
+                options.recordFile = argv[i + 1];
+            }
+            else if (option == "--trace") {
+                options.traceFile = argv[i + 1];
+            }
+            else if (option == "--report") {
+                options.reportFile = argv[i + 1];
+                getReportFormat(options.reportFile);
+            }
+            else if (option == "--spill") {
+                options.spillFile = argv[i + 1];
+            }
+            else if (option == "--log-level") {
+                setLogLevel(parseLogLevel(argv[i + 1]));
+            }
+            else {
+                return -1;
+            }
+            i += 2;
+        }
+    }
+    catch (const std::logic_error&) {
+        return -1;
+    }
+    catch (const std::string&) {
+        return -1;
+    }
+
+    if ((options.checkpointEvery > 0 || options.stopAt > 0) && options.checkpointFile.empty()) {
+        return -1;
+    }
+    // An event log starts from the pending orders, so it cannot begin mid-run
+    if (!options.recordFile.empty() && !options.resumeFile.empty()) {
+        return -1;
+    }
+    // A checkpoint holds the finished orders, which a spilling run no longer keeps
+    if (!options.spillFile.empty() && (!options.checkpointFile.empty() || !options.resumeFile.empty())) {
+        return -1;
+    }
+    // The fast-forward engine has no iterations to checkpoint or record
+    if (options.fastForward && (!options.checkpointFile.empty() || !options.resumeFile.empty() || !options.recordFile.empty() || !options.traceFile.empty() || options.metrics)) {
+        return -1;
+    }
+    return i;
+}
+
+// Loads the four batch-mode files (comma stations, pipe stations, orders, line)
+Scenario loadBatchScenario(char* argv[]) {
+    return loadScenario(argv[0], argv[1], argv[2], argv[3]);
+}
+
+// --optimize: search station orderings and write the best AssemblyLine.txt found
+int runOptimizer(int argc, char* argv[]) {
+    if (argc != 6 && argc != 7) {
+        std::cerr << "Usage: " << argv[0] << " --optimize <stations1> <stations2> <orders> <line> [output]\n";
+        return 1;
+    }
+
+    try {
+        Scenario scenario = loadBatchScenario(argv + 2);
+        LineOptimizer optimizer(scenario);
+
+        LineFitness original = optimizer.getFitness(scenario.getLine());
+        std::vector<std::string> best = optimizer.optimize();
+        LineFitness fitness = optimizer.getFitness(best);
+
+        std::cout << "Configured line: " << original.m_completed << " completed in "
+                  << original.m_iterations << " iterations\n";
+        std::cout << "Best line found: " << fitness.m_completed << " completed in "
+                  << fitness.m_iterations << " iterations\n";
+        std::cout << "Orderings evaluated: " << optimizer.getEvaluationCount() << "\n";
+
+        if (argc == 7) {
+            std::ofstream output(argv[6]);
+            if (!output) {
+                throw std::string("Unable to open ") + argv[6];
+            }
+            LineOptimizer::writeLine(output, best);
+            std::cout << "Best line written to " << argv[6] << "\n";
+        }
+        else {
+            std::cout << "\n";
+            LineOptimizer::writeLine(std::cout, best);
+        }
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+// --sweep: run every combination of the given station quantities in parallel
+int runSweep(int argc, char* argv[]) {
+    if (argc < 7) {
+        std::cerr << "Usage: " << argv[0] << " --sweep <stations1> <stations2> <orders> <line> <Station=from:to[:step]|Station=q1,q2,...>...\n";
+        return 1;
+    }
+
+    try {
+        Scenario scenario = loadBatchScenario(argv + 2);
+        InventorySweep sweep(scenario);
+        for (int i = 6; i < argc; i++) {
+            sweep.addAxis(InventorySweep::parseAxis(argv[i]));
+        }
+
+        std::cout << "Sweeping " << sweep.getPointCount() << " inventory points...\n\n";
+        sweep.writeTable(std::cout, sweep.run());
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+// --engine: run the line on the policy engine chosen by a comma-separated list
+int runEngine(int argc, char* argv[]) {
+    if (argc != 7) {
+        std::cerr << "Usage: " << argv[0] << " --engine <fill-one|fill-all,fifo|priority,log|quiet> <stations1> <stations2> <orders> <line>\n";
+        return 1;
+    }
+
+    try {
+        EnginePolicies policies = parseEnginePolicies(argv[2]);
+        Scenario scenario = loadBatchScenario(argv + 3);
+        std::unique_ptr<LineEngine> engine = makeLineEngine(policies, scenario, scenario.getLine());
+        SimulationResult result = engine->run(std::cout);
+
+        OutputBuffer output(std::cout);
+        output << "\nCompleted Orders:\n";
+        for (const auto& order : engine->getCompleted()) {
+            order.display(output);
+        }
+
+        output << "\nIncomplete Orders:\n";
+        for (const auto& order : engine->getIncomplete()) {
+            order.display(output);
+        }
+
+        output << "\nRemaining Inventory:\n";
+        for (const auto& station : engine->getStations()) {
+            station.display(output, true);
+        }
+        output << '\n' << result.m_completed << " completed, " << result.m_incomplete
+               << " incomplete in " << result.m_iterations << " iterations\n";
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+// --batch: run every scenario of a manifest and write their results to a directory
+int runBatch(int argc, char* argv[]) {
+    if (argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " --batch <manifest> <output directory> [workers]\n";
+        return 1;
+    }
+
+    try {
+        size_t workers = argc == 5 ? std::stoul(argv[4]) : 0;
+        BatchRunner runner(workers);
+        runner.loadManifest(argv[2]);
+        std::vector<BatchOutcome> outcomes = runner.run(argv[3]);
+
+        size_t failed = std::count_if(outcomes.begin(), outcomes.end(), [](const BatchOutcome& outcome) {
+            return !outcome.m_error.empty();
+        });
+        std::cout << "Ran " << outcomes.size() - failed << " of " << outcomes.size() << " scenarios from "
+                  << runner.getFilesParsed() << " parsed files (" << runner.getScenariosBuilt() << " distinct inputs)\n";
+        std::cout << "Results written to " << argv[3] << "\n";
+        if (failed > 0) {
+            std::cerr << failed << " scenarios failed; see " << argv[3] << "/summary.txt\n";
+            return 2;
+        }
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    catch (const std::logic_error&) {
+        std::cerr << "Error: invalid worker count " << argv[4] << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// --shared-lines: run several lines at once against one shared stock room
+int runSharedLines(int argc, char* argv[]) {
+    if (argc < 7 || (argc - 7) % 2 != 0) {
+        std::cerr << "Usage: " << argv[0] << " --shared-lines <first-come|equal-share> <stations1> <stations2> <orders> <line> [<orders> <line>]...\n";
+        return 1;
+    }
+
+    try {
+        InventoryFairness fairness = parseInventoryFairness(argv[2]);
+        Scenario stock = loadBatchScenario(argv + 3);
+        SharedLineRunner runner(stock, fairness);
+        runner.addLine("1", stock);
+        // Further lines take their stations from the same files as the first
+        for (int i = 7; i < argc; i += 2) {
+            runner.addLine(std::to_string(runner.getLineCount() + 1), loadScenario(argv[3], argv[4], argv[i], argv[i + 1]));
+        }
+
+        std::cout << "Running " << runner.getLineCount() << " lines on shared inventory...\n\n";
+        runner.run();
+        runner.writeReport(std::cout);
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+// Set while --serve runs so SIGINT/SIGTERM can stop the server
+SimulationServer* g_server = nullptr;
+
+void stopServer(int) {
+    if (g_server) g_server->stop();
+}
+
+// --serve: keep scenarios loaded and answer requests on a Unix domain socket
+int runServer(int argc, char* argv[]) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " --serve <socket> [workers]\n";
+        return 1;
+    }
+
+    try {
+        size_t workers = argc == 4 ? std::stoul(argv[3]) : 0;
+        SimulationServer server(workers);
+        g_server = &server;
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+
+        std::cout << "Serving on " << argv[2] << "\n" << std::flush;
+        server.serve(argv[2]);
+        g_server = nullptr;
+        std::cout << "Server stopped\n";
+    }
+    catch (const std::string& msg) {
+        g_server = nullptr;
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    catch (const std::logic_error&) {
+        std::cerr << "Error: invalid worker count " << argv[3] << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    SENECA_PROFILE_REPORT_AT_EXIT();
+    SENECA_MEMORY_REPORT_AT_EXIT();
     std::vector<Workstation*> stations;
     LineManager* lineManager = nullptr;
     bool stationsLoaded = false;
@@ -39,77 +368,254 @@ int main(int argc, char* argv[]) {
     std::cout << "Factory Assembly Line Simulator\n";
     std::cout << "================================\n";
     
+    if (argc > 1 && std::string(argv[1]) == "--optimize") {
+        return runOptimizer(argc, argv);
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--sweep") {
+        return runSweep(argc, argv);
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        return runBatch(argc, argv);
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--shared-lines") {
+        return runSharedLines(argc, argv);
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        return runServer(argc, argv);
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--engine") {
+        return runEngine(argc, argv);
+    }
+    
     if (argc > 1) {
         std::cout << "Command line arguments detected. Running in batch mode...\n";
         
-        if (argc != 5) {
+        BatchOptions options;
+        int first = parseBatchOptions(argc, argv, options);
+        if (first < 0 || argc - first != 4) {
             std::cerr << "Error: Batch mode requires 4 arguments:\n";
             std::cerr << "  1. Stations file 1 (comma-delimited)\n";
             std::cerr << "  2. Stations file 2 (pipe-delimited)\n";
             std::cerr << "  3. Customer orders file\n";
             std::cerr << "  4. Assembly line configuration file\n";
+            std::cerr << "Options (before the files):\n";
+            std::cerr << "  --checkpoint <file>      checkpoint file to write\n";
+            std::cerr << "  --checkpoint-every <n>   checkpoint every n iterations\n";
+            std::cerr << "  --stop-at <n>            checkpoint and stop after iteration n\n";
+            std::cerr << "  --resume <file>          continue from a checkpoint\n";
+            std::cerr << "  --record <file>          write a binary event log (not with --resume)\n";
+            std::cerr << "  --fast-forward           compute the results without ticking (no iteration log)\n";
+            std::cerr << "  --trace <file>           write a Chrome/Perfetto trace of the run\n";
+            std::cerr << "  --report <file>          write the results as .csv or .jsonl\n";
+            std::cerr << "  --spill <file>           stream finished orders to a file instead of memory\n";
+            std::cerr << "  --metrics                print per-station metrics after the results\n";
+            std::cerr << "  --log-level <level>      off, summary, iteration or fill (default)\n";
+            std::cerr << "  --perf                   print hardware counters per phase (Linux)\n";
             return 1;
         }
+        char** files = argv + first;
         
         try {
-            // Load stations
-            Utilities::setDelimiter(',');
-            std::ifstream file1(argv[1]);
-            if (!file1) {
-                throw std::string("Unable to open ") + argv[1];
+            // Hardware counters for the load, configure, simulate and report phases
+            std::unique_ptr<PerfPhases> perf;
+            if (options.perf) {
+                perf = std::make_unique<PerfPhases>();
             }
             
+            // Load stations
+            SENECA_MEMORY_PHASE(Load);
             std::string record;
-            while (std::getline(file1, record)) {
-                stations.push_back(new Workstation(record));
+            {
+                SENECA_PROFILE_ZONE("load.stations");
+                Utilities::setDelimiter(',');
+                std::ifstream file1(files[0]);
+                if (!file1) {
+                    throw std::string("Unable to open ") + files[0];
+                }
+                
+                while (std::getline(file1, record)) {
+                    stations.push_back(new Workstation(record));
+                }
+                file1.close();
+                
+                Utilities::setDelimiter('|');
+                std::ifstream file2(files[1]);
+                if (!file2) {
+                    throw std::string("Unable to open ") + files[1];
+                }
+                
+                while (std::getline(file2, record)) {
+                    stations.push_back(new Workstation(record));
+                }
+                file2.close();
             }
-            file1.close();
             
-            Utilities::setDelimiter('|');
-            std::ifstream file2(argv[2]);
-            if (!file2) {
-                throw std::string("Unable to open ") + argv[2];
+            // Load customer orders (a resumed run takes them from the checkpoint)
+            if (options.resumeFile.empty()) {
+                SENECA_PROFILE_ZONE("load.orders");
+                std::ifstream orderFile(files[2]);
+                if (!orderFile) {
+                    throw std::string("Unable to open ") + files[2];
+                }
+                
+                while (std::getline(orderFile, record)) {
+                    CustomerOrder order(record);
+                    SENECA_MEMORY_TAG(DequeChunks);
+                    g_pending.push_back(std::move(order));
+                }
+                orderFile.close();
             }
             
-            while (std::getline(file2, record)) {
-                stations.push_back(new Workstation(record));
-            }
-            file2.close();
+            if (perf) perf->end("load");
+            SENECA_MEMORY_PHASE(Configure);
+            
+            // Configure assembly line
+            lineManager = new LineManager(files[3], stations);
+            lineManager->reorderStations();
             
-            // Load customer orders
-            std::ifstream orderFile(argv[3]);
-            if (!orderFile) {
-                throw std::string("Unable to open ") + argv[3];
+            // Run simulation
+            if (options.resumeFile.empty()) {
+                std::cout << "\nRunning simulation...\n";
+            }
+            else {
+                restoreCheckpoint(options.resumeFile, *lineManager, stations);
+                std::cout << "\nResuming simulation after iteration " << lineManager->getIterationCount() << "...\n";
             }
             
-            while (std::getline(orderFile, record)) {
-                CustomerOrder order(record);
-                g_pending.push_back(std::move(order));
+            std::ofstream recordFile;
+            std::unique_ptr<EventRecorder> recorder;
+            if (!options.recordFile.empty()) {
+                recordFile.open(options.recordFile, std::ios::binary | std::ios::trunc);
+                if (!recordFile) {
+                    throw std::string("Unable to open ") + options.recordFile;
+                }
+                recorder = std::make_unique<EventRecorder>(recordFile, *lineManager);
             }
-            orderFile.close();
             
-            // Configure assembly line
-            lineManager = new LineManager(argv[4], stations);
-            lineManager->reorderStations();
+            // The iteration log is formatted and written on a background
+            // thread; the line itself reports to a stream that discards it
+            std::ostream discard(nullptr);
+            AsyncLogger logger(std::cout);
+            ObserverList observers;
+            observers.add(&logger);
+            observers.add(recorder.get());
+            std::ofstream traceFile;
+            std::unique_ptr<TraceExporter> trace;
+            if (!options.traceFile.empty()) {
+                traceFile.open(options.traceFile, std::ios::trunc);
+                if (!traceFile) {
+                    throw std::string("Unable to open ") + options.traceFile;
+                }
+                trace = std::make_unique<TraceExporter>(traceFile, *lineManager);
+                observers.add(trace.get());
+            }
+            std::unique_ptr<MetricsCollector> metrics;
+            if (options.metrics) {
+                metrics = std::make_unique<MetricsCollector>(*lineManager);
+                observers.add(metrics.get());
+            }
+            lineManager->setObserver(&observers);
             
-            // Run simulation
-            std::cout << "\nRunning simulation...\n";
-            while (!lineManager->run(std::cout));
+            // Finished orders go to disk as they leave the line; the report reads them back
+            std::unique_ptr<SpillFileSink> spill;
+            if (!options.spillFile.empty()) {
+                spill = std::make_unique<SpillFileSink>(options.spillFile);
+                lineManager->setResultSink(spill.get());
+            }
             
-            // Display results
-            std::cout << "\nCompleted Orders:\n";
-            for (const auto& order : g_completed) {
-                order.display(std::cout);
+            if (!options.checkpointFile.empty()) {
+                std::signal(SIGINT, requestStop);
+                std::signal(SIGTERM, requestStop);
             }
             
-            std::cout << "\nIncomplete Orders:\n";
-            for (const auto& order : g_incomplete) {
-                order.display(std::cout);
+            if (perf) perf->end("configure");
+            SENECA_MEMORY_PHASE(Simulate);
+            
+            bool finished = false;
+            if (options.fastForward) {
+                fastForward(lineManager->getActiveLine(), spill.get());
+                finished = true;
             }
+            while (!finished) {
+                finished = lineManager->run(discard);
+                if (finished || options.checkpointFile.empty()) continue;
+                
+                size_t iteration = lineManager->getIterationCount();
+                bool stopping = g_stopRequested || iteration == options.stopAt;
+                if (stopping || (options.checkpointEvery > 0 && iteration % options.checkpointEvery == 0)) {
+                    saveCheckpoint(options.checkpointFile, *lineManager, stations);
+                }
+                if (stopping) {
+                    logger.close();
+                    std::cout << "\nSimulation paused after iteration " << iteration
+                              << ". Checkpoint written to " << options.checkpointFile << "\n";
+                    break;
+                }
+            }
+            
+            if (perf) perf->end("simulate");
+            SENECA_MEMORY_PHASE(Report);
+            
+            // Display results (a paused run reports them when it is resumed)
+            logger.close();
+            if (trace) trace->finish();
+            if (spill) spill->flush();
+            auto forEachFinished = [&](bool completed, auto&& fn) {
+                if (spill) {
+                    readSpillFile(spill->getFile(), completed, fn);
+                    return;
+                }
+                for (const auto& order : completed ? g_completed : g_incomplete) {
+                    fn(order);
+                }
+            };
+            if (finished && isLogEnabled<LogLevel::Summary>()) {
+                SENECA_PROFILE_ZONE("report");
+                OutputBuffer output(std::cout);
+                auto display = [&](const CustomerOrder& order) {
+                    order.display(output);
+                };
+                output << "\nCompleted Orders:\n";
+                forEachFinished(true, display);
+            
+                output << "\nIncomplete Orders:\n";
+                forEachFinished(false, display);
             
-            std::cout << "\nRemaining Inventory:\n";
-            for (const auto* station : stations) {
-                station->Station::display(std::cout, true);
+                output << "\nRemaining Inventory:\n";
+                for (const auto* station : stations) {
+                    station->Station::display(output, true);
+                }
+            }
+            if (finished && !options.reportFile.empty()) {
+                std::ofstream reportFile(options.reportFile, std::ios::trunc);
+                if (!reportFile) {
+                    throw std::string("Unable to open ") + options.reportFile;
+                }
+                ReportWriter report(reportFile, getReportFormat(options.reportFile));
+                forEachFinished(true, [&](const CustomerOrder& order) {
+                    report.writeOrder(order, true);
+                });
+                forEachFinished(false, [&](const CustomerOrder& order) {
+                    report.writeOrder(order, false);
+                });
+                for (const auto* station : stations) {
+                    report.writeStation(*station);
+                }
+                report.flush();
+            }
+            if (finished && metrics) {
+                std::cout << "\n";
+                metrics->report(std::cout);
+            }
+            if (perf) {
+                perf->end("report");
+                std::cout << "\n";
+                perf->report(std::cout);
             }
         }
         catch (const std::string& msg) {
@@ -255,8 +761,9 @@ int main(int argc, char* argv[]) {
                         std::cout << "=         Stations (summary)           =\n";
                         std::cout << "========================================\n";
                         
+                        OutputBuffer output(std::cout);
                         for (const auto* station : stations) {
-                            station->Station::display(std::cout, false);
+                            station->Station::display(output, false);
                         }
                         break;
                     }
@@ -271,8 +778,9 @@ int main(int argc, char* argv[]) {
                         std::cout << "=          Stations (full)             =\n";
                         std::cout << "========================================\n";
                         
+                        OutputBuffer output(std::cout);
                         for (const auto* station : stations) {
-                            station->Station::display(std::cout, true);
+                            station->Station::display(output, true);
                         }
                         break;
                     }
@@ -287,8 +795,9 @@ int main(int argc, char* argv[]) {
                         std::cout << "=                Orders                =\n";
                         std::cout << "========================================\n";
                         
+                        OutputBuffer output(std::cout);
                         for (const auto& order : g_pending) {
-                            order.display(std::cout);
+                            order.display(output);
                         }
                         break;
                     }
@@ -334,8 +843,9 @@ int main(int argc, char* argv[]) {
                         std::cout << "=      Processed Orders (complete)     =\n";
                         std::cout << "========================================\n";
                         
+                        OutputBuffer output(std::cout);
                         for (const auto& order : g_completed) {
-                            order.display(std::cout);
+                            order.display(output);
                         }
                         break;
                     }
@@ -350,8 +860,9 @@ int main(int argc, char* argv[]) {
                         std::cout << "=     Processed Orders (incomplete)    =\n";
                         std::cout << "========================================\n";
                         
+                        OutputBuffer output(std::cout);
                         for (const auto& order : g_incomplete) {
-                            order.display(std::cout);
+                            order.display(output);
                         }
                         break;
                     }
@@ -366,8 +877,9 @@ int main(int argc, char* argv[]) {
                         std::cout << "=          Inventory (full)            =\n";
                         std::cout << "========================================\n";
                         
+                        OutputBuffer output(std::cout);
                         for (const auto* station : stations) {
-                            station->Station::display(std::cout, true);
+                            station->Station::display(output, true);
                         }
                         break;
                     }
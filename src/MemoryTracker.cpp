@@ -0,0 +1,195 @@
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "MemoryTracker.h"
+#include "OutputBuffer.h"
+
+namespace seneca {
+	namespace {
+		const char* const c_phaseNames[c_memoryPhases] = {
+			"startup", "load", "configure", "simulate", "report"
+		};
+		const char* const c_tagNames[c_memoryTags] = {
+			"other", "station-strings", "order-items", "deque-chunks", "log-formatting"
+		};
+
+		struct MemoryCell {
+			std::atomic<uint64_t> m_allocations{0};
+			std::atomic<uint64_t> m_bytes{0};
+			std::atomic<uint64_t> m_live{0};
+			std::atomic<uint64_t> m_peakLive{0};
+		};
+
+		// Zero-initialized before any allocation, so the tracker works during
+		// static initialization too
+		MemoryCell g_cells[c_memoryPhases * c_memoryTags];
+		MemoryCell g_total;
+		std::atomic<uint64_t> g_phasePeak[c_memoryPhases];
+		std::atomic<int> g_phase{0};
+		thread_local MemoryTag t_tag = MemoryTag::Other;
+
+		void raise(std::atomic<uint64_t>& peak, uint64_t value) {
+			uint64_t current = peak.load(std::memory_order_relaxed);
+			while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed));
+		}
+
+		void add(MemoryCell& cell, size_t size) {
+			cell.m_allocations.fetch_add(1, std::memory_order_relaxed);
+			cell.m_bytes.fetch_add(size, std::memory_order_relaxed);
+			raise(cell.m_peakLive, cell.m_live.fetch_add(size, std::memory_order_relaxed) + size);
+		}
+
+		MemoryStats read(const MemoryCell& cell) {
+			MemoryStats stats;
+			stats.m_allocations = cell.m_allocations.load(std::memory_order_relaxed);
+			stats.m_bytes = cell.m_bytes.load(std::memory_order_relaxed);
+			stats.m_live = cell.m_live.load(std::memory_order_relaxed);
+			stats.m_peakLive = cell.m_peakLive.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		void writeMemoryReportToStderr() {
+			std::cerr << "\n";
+			writeMemoryReport(std::cerr);
+		}
+	}
+
+	const char* getMemoryPhaseName(MemoryPhase phase) {
+		return c_phaseNames[static_cast<size_t>(phase)];
+	};
+
+	const char* getMemoryTagName(MemoryTag tag) {
+		return c_tagNames[static_cast<size_t>(tag)];
+	};
+
+	void setMemoryPhase(MemoryPhase phase) {
+		g_phase.store(static_cast<int>(phase), std::memory_order_relaxed);
+	};
+
+	MemoryPhase getMemoryPhase() {
+		return static_cast<MemoryPhase>(g_phase.load(std::memory_order_relaxed));
+	};
+
+	MemoryTag getMemoryTag() {
+		return t_tag;
+	};
+
+	void setMemoryTag(MemoryTag tag) {
+		t_tag = tag;
+	};
+
+	uint32_t trackAllocation(size_t size) {
+		size_t phase = static_cast<size_t>(g_phase.load(std::memory_order_relaxed));
+		uint32_t cell = static_cast<uint32_t>(phase * c_memoryTags + static_cast<size_t>(t_tag));
+		add(g_cells[cell], size);
+		g_total.m_allocations.fetch_add(1, std::memory_order_relaxed);
+		g_total.m_bytes.fetch_add(size, std::memory_order_relaxed);
+		uint64_t live = g_total.m_live.fetch_add(size, std::memory_order_relaxed) + size;
+		raise(g_total.m_peakLive, live);
+		raise(g_phasePeak[phase], live);
+		return cell;
+	};
+
+	void trackDeallocation(uint32_t cell, size_t size) {
+		g_cells[cell].m_live.fetch_sub(size, std::memory_order_relaxed);
+		g_total.m_live.fetch_sub(size, std::memory_order_relaxed);
+	};
+
+	MemoryStats getMemoryStats(MemoryPhase phase, MemoryTag tag) {
+		return read(g_cells[static_cast<size_t>(phase) * c_memoryTags + static_cast<size_t>(tag)]);
+	};
+
+	MemoryStats getMemoryTotals() {
+		return read(g_total);
+	};
+
+	uint64_t getMemoryPhasePeak(MemoryPhase phase) {
+		return g_phasePeak[static_cast<size_t>(phase)].load(std::memory_order_relaxed);
+	};
+
+	// VmHWM rather than ru_maxrss, which resetPeakRss does not restart
+	uint64_t getPeakRssKilobytes() {
+#if defined(__linux__)
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line)) {
+			if (line.compare(0, 6, "VmHWM:") == 0) return std::strtoull(line.c_str() + 6, nullptr, 10);
+		};
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+		return static_cast<uint64_t>(usage.ru_maxrss) / 1024;	// bytes on macOS
+#else
+		return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#else
+		return 0;
+#endif
+	};
+
+	bool resetPeakRss() {
+#if defined(__linux__)
+		std::ofstream clear("/proc/self/clear_refs");
+		clear << "5";
+		clear.close();
+		return clear.good();
+#else
+		return false;
+#endif
+	};
+
+	// Reads every figure before the report's buffer is allocated, so the
+	// report does not count itself
+	void writeMemoryReport(std::ostream& os) {
+		MemoryStats total = getMemoryTotals();
+		MemoryStats stats[c_memoryPhases][c_memoryTags];
+		uint64_t peaks[c_memoryPhases];
+		for (size_t phase = 0; phase < c_memoryPhases; phase++) {
+			for (size_t tag = 0; tag < c_memoryTags; tag++) {
+				stats[phase][tag] = getMemoryStats(static_cast<MemoryPhase>(phase), static_cast<MemoryTag>(tag));
+			};
+			peaks[phase] = getMemoryPhasePeak(static_cast<MemoryPhase>(phase));
+		};
+		uint64_t peakRss = getPeakRssKilobytes();
+
+		OutputBuffer output(os);
+		output << "Memory Report (bytes):\n";
+		output << "Allocations " << total.m_allocations << ", allocated " << total.m_bytes
+			<< ", live " << total.m_live << ", peak live " << total.m_peakLive
+			<< ", peak RSS " << peakRss * 1024 << "\n\n";
+
+		output.writeLeft("Phase", 11).writeLeft("Component", 17)
+			.writeRight("Allocations", 13).writeRight("Allocated", 14)
+			.writeRight("Live", 12).writeRight("Peak live", 12) << "\n";
+		for (size_t phase = 0; phase < c_memoryPhases; phase++) {
+			for (size_t tag = 0; tag < c_memoryTags; tag++) {
+				const MemoryStats& cell = stats[phase][tag];
+				if (cell.m_allocations == 0) continue;
+				output.writeLeft(c_phaseNames[phase], 11).writeLeft(c_tagNames[tag], 17)
+					.writeRight(cell.m_allocations, 13).writeRight(cell.m_bytes, 14)
+					.writeRight(cell.m_live, 12).writeRight(cell.m_peakLive, 12) << "\n";
+			};
+		};
+
+		output << "\n";
+		output.writeLeft("Phase", 11).writeRight("Peak live (all)", 16) << "\n";
+		for (size_t phase = 0; phase < c_memoryPhases; phase++) {
+			if (peaks[phase] == 0) continue;
+			output.writeLeft(c_phaseNames[phase], 11).writeRight(peaks[phase], 16) << "\n";
+		};
+	};
+
+	void writeMemoryReportAtExit() {
+		static bool s_registered = false;
+		if (s_registered) return;
+		s_registered = true;
+		std::atexit(writeMemoryReportToStderr);
+	};
+}
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include "CustomerOrder.h"
+#include "Metrics.h"
+#include "OutputBuffer.h"
+#include "Workstation.h"
+
+namespace seneca {
+	namespace {
+		void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+			counter.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		void raise(std::atomic<uint64_t>& maximum, uint64_t value) {
+			uint64_t current = maximum.load(std::memory_order_relaxed);
+			while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed));
+		}
+
+		uint64_t read(const std::atomic<uint64_t>& counter) {
+			return counter.load(std::memory_order_relaxed);
+		}
+	}
+
+	void LogHistogram::record(uint64_t value) {
+		bump(m_buckets[bucketOf(value)]);
+		bump(m_count);
+		bump(m_sum, value);
+		raise(m_max, value);
+	};
+
+	uint64_t LogHistogram::getCount() const {
+		return read(m_count);
+	};
+
+	uint64_t LogHistogram::getMax() const {
+		return read(m_max);
+	};
+
+	double LogHistogram::getMean() const {
+		uint64_t count = getCount();
+		return count == 0 ? 0.0 : static_cast<double>(read(m_sum)) / count;
+	};
+
+	uint64_t LogHistogram::getBucket(size_t bucket) const {
+		return read(m_buckets[bucket]);
+	};
+
+	uint64_t LogHistogram::getPercentile(double p) const {
+		uint64_t count = getCount();
+		if (count == 0) return 0;
+
+		uint64_t rank = static_cast<uint64_t>(p * count);
+		if (rank < 1) rank = 1;
+		uint64_t seen = 0;
+		for (size_t i = 0; i < c_buckets; i++) {
+			seen += getBucket(i);
+			if (seen >= rank) return std::min(bucketHigh(i), getMax());
+		};
+		return getMax();
+	};
+
+	size_t LogHistogram::bucketOf(uint64_t value) {
+		size_t bucket = 0;
+		while (value > 0) {
+			value >>= 1;
+			bucket++;
+		};
+		return bucket;
+	};
+
+	uint64_t LogHistogram::bucketLow(size_t bucket) {
+		return bucket == 0 ? 0 : uint64_t(1) << (bucket - 1);
+	};
+
+	// Inclusive, so the last bucket does not overflow
+	uint64_t LogHistogram::bucketHigh(size_t bucket) {
+		return bucket == 0 ? 0 : bucketLow(bucket) + (bucketLow(bucket) - 1);
+	};
+
+	void LogHistogram::display(std::ostream& os) const {
+		OutputBuffer output(os, 1024);
+		display(output);
+	};
+
+	void LogHistogram::display(OutputBuffer& output) const {
+		bool first = true;
+		for (size_t i = 0; i < c_buckets; i++) {
+			uint64_t count = getBucket(i);
+			if (count == 0) continue;
+
+			if (!first) output << "  ";
+			if (bucketLow(i) == bucketHigh(i)) {
+				output << "[" << bucketLow(i) << "] " << count;
+			} else {
+				output << "[" << bucketLow(i) << "-" << bucketHigh(i) << "] " << count;
+			};
+			first = false;
+		};
+		if (first) output << "(none)";
+	};
+
+	void QueueSeries::record(uint64_t length) {
+		uint64_t recorded = read(m_recorded);
+		uint64_t window = read(m_window);
+		size_t point = static_cast<size_t>(recorded / window);
+		if (point == c_points) {
+			for (size_t i = 0; i < c_points / 2; i++) {
+				m_peaks[i].store(std::max(read(m_peaks[2 * i]), read(m_peaks[2 * i + 1])), std::memory_order_relaxed);
+			};
+			for (size_t i = c_points / 2; i < c_points; i++) {
+				m_peaks[i].store(0, std::memory_order_relaxed);
+			};
+			m_window.store(window * 2, std::memory_order_relaxed);
+			point = c_points / 2;
+		};
+		raise(m_peaks[point], length);
+		bump(m_recorded);
+	};
+
+	uint64_t QueueSeries::getWindow() const {
+		return read(m_window);
+	};
+
+	// The last window may still be filling. record doubles the window before
+	// the count can pass c_points.
+	size_t QueueSeries::getPointCount() const {
+		uint64_t window = getWindow();
+		return static_cast<size_t>((read(m_recorded) + window - 1) / window);
+	};
+
+	uint64_t QueueSeries::getPoint(size_t point) const {
+		return read(m_peaks[point]);
+	};
+
+	void QueueSeries::display(std::ostream& os) const {
+		OutputBuffer output(os, 1024);
+		display(output);
+	};
+
+	void QueueSeries::display(OutputBuffer& output) const {
+		size_t points = getPointCount();
+		if (points == 0) output << "(none)";
+		for (size_t i = 0; i < points; i++) {
+			output << (i == 0 ? "" : " ") << getPoint(i);
+		};
+	};
+
+	MetricsCollector::MetricsCollector(const LineManager& manager) : m_stations(manager.getActiveLine().size()) {
+		const auto& line = manager.getActiveLine();
+		m_line.assign(line.begin(), line.end());
+		for (size_t i = 0; i < line.size(); i++) {
+			m_stationIndex[line[i]] = i;
+			m_stations[i].m_name = line[i]->getItemName();
+		};
+		m_queueLength.resize(line.size());
+		m_filled.resize(line.size());
+		m_stockOut.resize(line.size());
+	};
+
+	size_t MetricsCollector::indexOf(const Station& station) const {
+		auto it = m_stationIndex.find(&station);
+		if (it == m_stationIndex.end()) throw std::string("Metrics for a station outside the line: ") + station.getItemName();
+		return it->second;
+	};
+
+	// Orders already in the line when the collector was attached have no
+	// arrival time and are left out of the wait and latency figures
+	void MetricsCollector::depart(size_t station, const CustomerOrder& order) {
+		auto it = m_arrived.find(order.getId());
+		if (it == m_arrived.end()) return;
+
+		m_stations[station].m_wait.record(m_iteration - it->second + 1);
+		m_arrived.erase(it);
+	};
+
+	void MetricsCollector::onIteration(size_t iteration) {
+		m_iteration = iteration;
+		for (size_t i = 0; i < m_line.size(); i++) {
+			m_queueLength[i] = m_line[i]->getQueueLength();
+			m_filled[i] = false;
+			m_stockOut[i] = false;
+		};
+	};
+
+	void MetricsCollector::onAdmit(const Workstation& station, const CustomerOrder& order) {
+		m_queueLength[indexOf(station)]++;
+		m_arrived[order.getId()] = m_iteration;
+		m_admitted[order.getId()] = m_iteration;
+	};
+
+	void MetricsCollector::onFill(const Station& station, const CustomerOrder&, size_t, bool filled) {
+		size_t index = indexOf(station);
+		if (filled) {
+			bump(m_stations[index].m_fills);
+			m_filled[index] = true;
+		} else {
+			bump(m_stations[index].m_stockOuts);
+			m_stockOut[index] = true;
+		};
+	};
+
+	void MetricsCollector::onMove(const Workstation& from, const Workstation&, const CustomerOrder& order) {
+		bool known = m_arrived.count(order.getId()) > 0;
+		depart(indexOf(from), order);
+		// The next station first works on it in the following iteration
+		if (known) m_arrived[order.getId()] = m_iteration + 1;
+	};
+
+	void MetricsCollector::onFinish(const Workstation& station, const CustomerOrder& order, bool) {
+		depart(indexOf(station), order);
+
+		auto it = m_admitted.find(order.getId());
+		if (it == m_admitted.end()) return;
+		m_latency.record(m_iteration - it->second + 1);
+		m_admitted.erase(it);
+	};
+
+	void MetricsCollector::onIterationEnd(size_t) {
+		for (size_t i = 0; i < m_stations.size(); i++) {
+			StationMetrics& station = m_stations[i];
+			if (m_filled[i]) {
+				bump(station.m_busy);
+			} else if (m_stockOut[i]) {
+				bump(station.m_starved);
+			} else {
+				bump(station.m_idle);
+			};
+			bump(station.m_queueSum, m_queueLength[i]);
+			raise(station.m_queueMax, m_queueLength[i]);
+			station.m_queue.record(m_queueLength[i]);
+		};
+		bump(m_iterations);
+	};
+
+	const std::vector<StationMetrics>& MetricsCollector::getStations() const {
+		return m_stations;
+	};
+
+	const LogHistogram& MetricsCollector::getLatency() const {
+		return m_latency;
+	};
+
+	uint64_t MetricsCollector::getIterationCount() const {
+		return read(m_iterations);
+	};
+
+	// Buffered: a long line can have thousands of stations
+	void MetricsCollector::report(std::ostream& os) const {
+		OutputBuffer output(os);
+		uint64_t iterations = getIterationCount();
+
+		size_t width = 7;
+		for (const auto& station : m_stations) width = std::max(width, station.m_name.size());
+
+		output << "Station Metrics (" << iterations << " iterations):\n";
+		output.writeLeft("Station", width).writeRight("Busy", 7).writeRight("Idle", 7).writeRight("Starved", 9)
+			.writeRight("Fills", 7).writeRight("Stock-outs", 12)
+			.writeRight("Avg queue", 11).writeRight("Max queue", 11)
+			.writeRight("Avg wait", 10).writeRight("Max wait", 10) << "\n";
+		for (const auto& station : m_stations) {
+			double averageQueue = iterations == 0 ? 0.0 : static_cast<double>(read(station.m_queueSum)) / iterations;
+			output.writeLeft(station.m_name, width)
+				.writeRight(read(station.m_busy), 7).writeRight(read(station.m_idle), 7)
+				.writeRight(read(station.m_starved), 9).writeRight(read(station.m_fills), 7)
+				.writeRight(read(station.m_stockOuts), 12)
+				.writeFixed(averageQueue, 2, 11).writeRight(read(station.m_queueMax), 11)
+				.writeFixed(station.m_wait.getMean(), 2, 10).writeRight(station.m_wait.getMax(), 10) << "\n";
+		};
+
+		output << "\nOrder latency (iterations): " << m_latency.getCount() << " orders, mean ";
+		output.writeFixed(m_latency.getMean(), 2) << ", p50 <= " << m_latency.getPercentile(0.5)
+			<< ", p99 <= " << m_latency.getPercentile(0.99) << ", max " << m_latency.getMax() << "\n  ";
+		m_latency.display(output);
+		output << "\n\nWait per station (iterations):\n";
+		for (const auto& station : m_stations) {
+			output << "  ";
+			output.writeLeft(station.m_name, width) << "  ";
+			station.m_wait.display(output);
+			output << "\n";
+		};
+
+		uint64_t window = m_stations.empty() ? 1 : m_stations.front().m_queue.getWindow();
+		output << "\nQueue length per station (peak of every " << window << (window == 1 ? " iteration" : " iterations") << "):\n";
+		for (const auto& station : m_stations) {
+			output << "  ";
+			output.writeLeft(station.m_name, width) << "  ";
+			station.m_queue.display(output);
+			output << "\n";
+		};
+	};
+}
@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <cstring>
+#include "OutputBuffer.h"
+
+namespace seneca {
+	OutputBuffer::OutputBuffer(std::ostream& os, size_t capacity) : m_os(os), m_buffer(capacity == 0 ? 1 : capacity) {};
+
+	OutputBuffer::~OutputBuffer() {
+		try {
+			flush();
+		} catch (...) {
+		};
+	};
+
+	// Hands the buffered text to the stream to make room; anything larger than
+	// the whole buffer goes straight through
+	OutputBuffer& OutputBuffer::writeThrough(const char* data, size_t size) {
+		m_os.write(m_buffer.data(), m_size);
+		m_size = 0;
+		if (size >= m_buffer.size()) {
+			m_os.write(data, size);
+			return *this;
+		};
+		std::memcpy(m_buffer.data(), data, size);
+		m_size = size;
+		return *this;
+	};
+
+	OutputBuffer& OutputBuffer::operator<<(size_t value) {
+		return writeRight(value, 0);
+	};
+
+	OutputBuffer& OutputBuffer::pad(size_t count, char fill) {
+		if (m_size + count > m_buffer.size()) {
+			for (; count > 0; count--) *this << fill;
+			return *this;
+		};
+		std::memset(m_buffer.data() + m_size, fill, count);
+		m_size += count;
+		return *this;
+	};
+
+	OutputBuffer& OutputBuffer::writeRight(size_t value, size_t width, char fill) {
+		char digits[20];
+		size_t size = 0;
+		do {
+			digits[sizeof(digits) - ++size] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value > 0);
+		if (width > size) pad(width - size, fill);
+		return write(digits + sizeof(digits) - size, size);
+	};
+
+	OutputBuffer& OutputBuffer::writeLeft(const std::string& text, size_t width) {
+		*this << text;
+		return width > text.size() ? pad(width - text.size()) : *this;
+	};
+
+	OutputBuffer& OutputBuffer::writeRight(const std::string& text, size_t width) {
+		if (width > text.size()) pad(width - text.size());
+		return *this << text;
+	};
+
+	// printf's %f is what std::fixed formats with, so the digits match
+	OutputBuffer& OutputBuffer::writeFixed(double value, int decimals, size_t width) {
+		char digits[64];
+		int size = std::snprintf(digits, sizeof(digits), "%.*f", decimals, value);
+		if (size < 0) return *this;
+		if (static_cast<size_t>(size) < sizeof(digits)) {
+			if (width > static_cast<size_t>(size)) pad(width - size);
+			return write(digits, size);
+		};
+		std::string text(size + 1, '\0');
+		std::snprintf(&text[0], text.size(), "%.*f", decimals, value);
+		text.resize(size);
+		return writeRight(text, width);
+	};
+
+	void OutputBuffer::flush() {
+		if (m_size > 0) {
+			m_os.write(m_buffer.data(), m_size);
+			m_size = 0;
+		};
+		m_os.flush();
+	};
+
+	size_t OutputBuffer::getPending() const {
+		return m_size;
+	};
+}
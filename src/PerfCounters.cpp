@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "OutputBuffer.h"
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace seneca {
+	namespace {
+		const char* const c_eventNames[PerfSample::c_events] = {
+			"cycles", "instructions", "cache-misses", "branch-misses"
+		};
+
+#ifdef __linux__
+		const uint64_t c_eventConfigs[PerfSample::c_events] = {
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+		};
+
+		// User-space events of the calling thread on any CPU, counting from now.
+		// Threads it starts later inherit the event and add to its count.
+		int openEvent(uint64_t config) {
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = config;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.inherit = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+#endif
+	}
+
+	PerfSample& PerfSample::operator+=(const PerfSample& other) {
+		for (size_t i = 0; i < c_events; i++) m_values[i] += other.m_values[i];
+		return *this;
+	};
+
+	PerfSample PerfSample::operator-(const PerfSample& other) const {
+		PerfSample difference;
+		for (size_t i = 0; i < c_events; i++) {
+			difference.m_values[i] = m_values[i] >= other.m_values[i] ? m_values[i] - other.m_values[i] : 0;
+		};
+		return difference;
+	};
+
+	const char* getPerfEventName(size_t event) {
+		return event < PerfSample::c_events ? c_eventNames[event] : "";
+	};
+
+	PerfCounters::PerfCounters() {
+		std::fill(m_fd, m_fd + PerfSample::c_events, -1);
+#ifdef __linux__
+		for (size_t i = 0; i < PerfSample::c_events; i++) {
+			m_fd[i] = openEvent(c_eventConfigs[i]);
+			if (m_fd[i] < 0 && m_error.empty()) {
+				m_error = std::string("perf_event_open: ") + std::strerror(errno);
+			}
+		};
+#else
+		m_error = "hardware counters need Linux perf_event_open";
+#endif
+	};
+
+	PerfCounters::~PerfCounters() {
+#ifdef __linux__
+		for (int fd : m_fd) {
+			if (fd >= 0) close(fd);
+		};
+#endif
+	};
+
+	bool PerfCounters::isAvailable(size_t event) const {
+		return event < PerfSample::c_events && m_fd[event] >= 0;
+	};
+
+	bool PerfCounters::isAnyAvailable() const {
+		return std::any_of(m_fd, m_fd + PerfSample::c_events, [](int fd) { return fd >= 0; });
+	};
+
+	const std::string& PerfCounters::getError() const {
+		return m_error;
+	};
+
+	PerfSample PerfCounters::read() const {
+		PerfSample sample;
+#ifdef __linux__
+		for (size_t i = 0; i < PerfSample::c_events; i++) {
+			uint64_t values[3] = {};	// value, time enabled, time running
+			if (m_fd[i] < 0 || ::read(m_fd[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) continue;
+			if (values[2] == 0) continue;
+			sample.m_values[i] = values[2] < values[1]
+				? static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2])
+				: values[0];
+		};
+#endif
+		return sample;
+	};
+
+	PerfPhases::PerfPhases() : m_mark(m_counters.read()) {
+	};
+
+	void PerfPhases::begin() {
+		m_mark = m_counters.read();
+	};
+
+	void PerfPhases::end(const std::string& phase) {
+		PerfSample now = m_counters.read();
+		PerfSample delta = now - m_mark;
+		m_mark = now;
+
+		auto it = std::find_if(m_phases.begin(), m_phases.end(),
+			[&](const std::pair<std::string, PerfSample>& entry) { return entry.first == phase; });
+		if (it == m_phases.end()) {
+			m_phases.emplace_back(phase, delta);
+		}
+		else {
+			it->second += delta;
+		}
+	};
+
+	const PerfCounters& PerfPhases::getCounters() const {
+		return m_counters;
+	};
+
+	const std::vector<std::pair<std::string, PerfSample>>& PerfPhases::getPhases() const {
+		return m_phases;
+	};
+
+	void PerfPhases::report(std::ostream& os) const {
+		OutputBuffer output(os);
+		if (!m_counters.isAnyAvailable()) {
+			output << "Hardware Counters: unavailable (" << m_counters.getError() << ")\n";
+			return;
+		}
+
+		size_t width = 5;
+		for (const auto& phase : m_phases) width = std::max(width, phase.first.size());
+
+		output << "Hardware Counters (all threads, user space):\n";
+		output.writeLeft("Phase", width);
+		for (size_t i = 0; i < PerfSample::c_events; i++) output.writeRight(getPerfEventName(i), 16);
+		output.writeRight("IPC", 7) << "\n";
+
+		PerfSample total;
+		auto writeRow = [&](const std::string& name, const PerfSample& sample) {
+			output.writeLeft(name, width);
+			for (size_t i = 0; i < PerfSample::c_events; i++) {
+				if (m_counters.isAvailable(i)) {
+					output.writeRight(sample.m_values[i], 16);
+				}
+				else {
+					output.writeRight("n/a", 16);
+				}
+			};
+			if (m_counters.isAvailable(0) && m_counters.isAvailable(1) && sample.m_values[0] > 0) {
+				output.writeFixed(static_cast<double>(sample.m_values[1]) / sample.m_values[0], 2, 7);
+			}
+			else {
+				output.writeRight("n/a", 7);
+			}
+			output << "\n";
+		};
+		for (const auto& phase : m_phases) {
+			writeRow(phase.first, phase.second);
+			total += phase.second;
+		};
+		writeRow("total", total);
+		if (!m_counters.getError().empty()) output << "(some events unavailable: " << m_counters.getError() << ")\n";
+	};
+}
@@ -0,0 +1,205 @@
+#include <sstream>
+#include <utility>
+#include "LogLevel.h"
+#include "MemoryTracker.h"
+#include "PolicyEngine.h"
+
+namespace seneca {
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::PolicyEngine(const Scenario& scenario) : PolicyEngine(scenario, scenario.getLine()) {};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::PolicyEngine(const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay) {
+		{
+			SENECA_MEMORY_TAG(StationStrings);
+			m_stations = scenario.getStations();
+		}
+
+		auto findStation = [&](const std::string& name) {
+			for (size_t i = 0; i < m_stations.size(); i++) {
+				if (m_stations[i].getItemName() == name) return i;
+			};
+			return m_stations.size();
+		};
+
+		for (const auto& entry : overlay) {
+			size_t index = findStation(entry.first);
+			if (index == m_stations.size()) throw std::string("Unknown station in inventory overlay: ") + entry.first;
+			m_stations[index].setQuantity(entry.second);
+		};
+
+		for (const auto& name : line) {
+			size_t index = findStation(name);
+			if (index == m_stations.size()) throw std::string("Unknown station in line: ") + name;
+			m_line.push_back(index);
+		};
+		m_queues.resize(m_line.size());
+
+		// Each item is resolved to the line position that fills it, once, so the
+		// tick loop never compares station names
+		for (const auto& order : scenario.getOrders()) {
+			EngineOrder entry{order.clone(), {}, 0, m_pending.size()};
+			for (size_t i = 0; i < order.getItemCount(); i++) {
+				uint32_t position = c_offLine;
+				for (size_t p = 0; p < m_line.size() && position == c_offLine; p++) {
+					if (m_stations[m_line[p]].getItemName() == order.getItemName(i)) position = static_cast<uint32_t>(p);
+				};
+				entry.m_itemStations.push_back(position);
+				if (!order.isItemFilledAt(i)) entry.m_unfilled++;
+			};
+			m_pending.push_back(std::move(entry));
+		};
+		m_orders = m_pending.size();
+
+		if (m_line.empty() && m_orders > 0) throw std::string("Scenario has orders but no assembly line.");
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	void PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::fill(size_t position, std::ostream& os) {
+		EngineOrder& order = m_queues[position].top();
+		Station& station = m_stations[m_line[position]];
+
+		// The stock for every item wanted here (one under FillOne) is reserved
+		// at once, and the granted serial numbers go to the items in order
+		size_t wanted = 0;
+		for (size_t i = 0; i < order.m_itemStations.size(); i++) {
+			if (order.m_itemStations[i] == position && !order.m_order.isItemFilledAt(i)) wanted++;
+		};
+		if (wanted == 0) return;
+		StationReservation granted = station.reserve(FillPolicy::c_fillAll ? wanted : 1);
+
+		for (size_t i = 0; i < order.m_itemStations.size(); i++) {
+			if (order.m_itemStations[i] != position || order.m_order.isItemFilledAt(i)) continue;
+
+			if (granted.m_count > 0) {
+				order.m_order.fillItemAt(i, granted.m_firstSerial++);
+				granted.m_count--;
+				order.m_unfilled--;
+				if (LogPolicy::c_enabled && isLogEnabled<LogLevel::Fill>()) {
+					os << "    Filled " << order.m_order.getName() << ", " << order.m_order.getProduct() << " " << "[" << order.m_order.getItemName(i) << "]" << std::endl;
+				};
+				if (!FillPolicy::c_fillAll) return;
+			} else if (LogPolicy::c_enabled && isLogEnabled<LogLevel::Fill>()) {
+				os << "    Unable to fill " << order.m_order.getName() << ", " << order.m_order.getProduct() << " " << "[" << order.m_order.getItemName(i) << "]" << std::endl;
+			};
+		};
+	};
+
+	// Same test as Workstation::attemptToMoveOrder
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	bool PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::isDone(const EngineOrder& order, size_t position) const {
+		if (m_stations[m_line[position]].getQuantity() < 1) return true;
+		for (size_t i = 0; i < order.m_itemStations.size(); i++) {
+			if (order.m_itemStations[i] == position && !order.m_order.isItemFilledAt(i)) return false;
+		};
+		return true;
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	bool PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::step(std::ostream& os) {
+		++m_iteration;
+		if (LogPolicy::c_enabled && isLogEnabled<LogLevel::Iteration>()) os << "Line Manager Iteration: " << m_iteration << std::endl;
+
+		if (!m_pending.empty()) {
+			SENECA_MEMORY_TAG(DequeChunks);
+			m_pending.front().m_order.setId(m_orders - m_pending.size() + 1);
+			m_queues.front().push(std::move(m_pending.front()));
+			m_pending.pop_front();
+		};
+
+		for (size_t p = 0; p < m_line.size(); p++) {
+			if (!m_queues[p].empty()) fill(p, os);
+		};
+
+		// In line order, so an order can pass several stations in one iteration
+		for (size_t p = 0; p < m_line.size(); p++) {
+			if (m_queues[p].empty() || !isDone(m_queues[p].top(), p)) continue;
+
+			SENECA_MEMORY_TAG(DequeChunks);
+			EngineOrder order = m_queues[p].pop();
+			if (p + 1 < m_line.size()) {
+				m_queues[p + 1].push(std::move(order));
+			} else if (order.m_order.isOrderFilled()) {
+				m_completed.push_back(std::move(order.m_order));
+			} else {
+				m_incomplete.push_back(std::move(order.m_order));
+			};
+		};
+
+		return m_completed.size() + m_incomplete.size() == m_orders;
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	SimulationResult PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::run(std::ostream& os) {
+		while (!step(os));
+		return getResult();
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	SimulationResult PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::getResult() const {
+		SimulationResult result;
+		result.m_completed = m_completed.size();
+		result.m_incomplete = m_incomplete.size();
+		result.m_iterations = m_iteration;
+		return result;
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	const std::deque<CustomerOrder>& PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::getCompleted() const {
+		return m_completed;
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	const std::deque<CustomerOrder>& PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::getIncomplete() const {
+		return m_incomplete;
+	};
+
+	template <typename FillPolicy, typename QueuePolicy, typename LogPolicy>
+	const std::vector<Station>& PolicyEngine<FillPolicy, QueuePolicy, LogPolicy>::getStations() const {
+		return m_stations;
+	};
+
+	template class PolicyEngine<FillOne, FifoQueue, LogOn>;
+	template class PolicyEngine<FillOne, FifoQueue, LogOff>;
+	template class PolicyEngine<FillOne, PriorityQueue, LogOn>;
+	template class PolicyEngine<FillOne, PriorityQueue, LogOff>;
+	template class PolicyEngine<FillAll, FifoQueue, LogOn>;
+	template class PolicyEngine<FillAll, FifoQueue, LogOff>;
+	template class PolicyEngine<FillAll, PriorityQueue, LogOn>;
+	template class PolicyEngine<FillAll, PriorityQueue, LogOff>;
+
+	EnginePolicies parseEnginePolicies(const std::string& spec) {
+		EnginePolicies policies;
+		std::istringstream is(spec);
+		std::string policy;
+		while (std::getline(is, policy, ',')) {
+			if (policy == "fill-one") policies.m_fillAll = false;
+			else if (policy == "fill-all") policies.m_fillAll = true;
+			else if (policy == "fifo") policies.m_priority = false;
+			else if (policy == "priority") policies.m_priority = true;
+			else if (policy == "log") policies.m_logging = true;
+			else if (policy == "quiet") policies.m_logging = false;
+			else throw std::string("Unknown engine policy: ") + policy;
+		};
+		return policies;
+	};
+
+	namespace {
+		template <typename FillPolicy, typename QueuePolicy>
+		std::unique_ptr<LineEngine> makeWithLog(bool logging, const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay) {
+			if (logging) return std::make_unique<PolicyEngine<FillPolicy, QueuePolicy, LogOn>>(scenario, line, overlay);
+			return std::make_unique<PolicyEngine<FillPolicy, QueuePolicy, LogOff>>(scenario, line, overlay);
+		};
+
+		template <typename FillPolicy>
+		std::unique_ptr<LineEngine> makeWithQueue(const EnginePolicies& policies, const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay) {
+			if (policies.m_priority) return makeWithLog<FillPolicy, PriorityQueue>(policies.m_logging, scenario, line, overlay);
+			return makeWithLog<FillPolicy, FifoQueue>(policies.m_logging, scenario, line, overlay);
+		};
+	}
+
+	std::unique_ptr<LineEngine> makeLineEngine(const EnginePolicies& policies, const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay) {
+		if (policies.m_fillAll) return makeWithQueue<FillAll>(policies, scenario, line, overlay);
+		return makeWithQueue<FillOne>(policies, scenario, line, overlay);
+	};
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "OutputBuffer.h"
+#include "Profiler.h"
+
+namespace seneca {
+	namespace {
+		struct ProfileRegistry {
+			std::mutex m_mutex;
+			std::deque<ProfileZone> m_zones;	// a deque never moves its elements
+			uint64_t m_startTicks{readProfileClock()};
+			std::chrono::steady_clock::time_point m_startTime{std::chrono::steady_clock::now()};
+		};
+
+		ProfileRegistry& registry() {
+			static ProfileRegistry s_registry;
+			return s_registry;
+		}
+
+		uint64_t read(const std::atomic<uint64_t>& value) {
+			return value.load(std::memory_order_relaxed);
+		}
+
+		void writeProfileToStderr() {
+			std::cerr << "\n";
+			writeProfile(std::cerr);
+		}
+	}
+
+	ProfileZone& getProfileZone(const char* name, bool timed) {
+		ProfileRegistry& profile = registry();
+		std::lock_guard<std::mutex> lock(profile.m_mutex);
+		for (auto& zone : profile.m_zones) {
+			if (std::strcmp(zone.m_name, name) == 0) return zone;
+		};
+		profile.m_zones.emplace_back();
+		profile.m_zones.back().m_name = name;
+		profile.m_zones.back().m_timed = timed;
+		return profile.m_zones.back();
+	};
+
+	std::vector<const ProfileZone*> getProfileZones() {
+		ProfileRegistry& profile = registry();
+		std::lock_guard<std::mutex> lock(profile.m_mutex);
+		std::vector<const ProfileZone*> zones;
+		for (const auto& zone : profile.m_zones) {
+			zones.push_back(&zone);
+		};
+		return zones;
+	};
+
+	void resetProfile() {
+		ProfileRegistry& profile = registry();
+		std::lock_guard<std::mutex> lock(profile.m_mutex);
+		for (auto& zone : profile.m_zones) {
+			zone.m_calls.store(0, std::memory_order_relaxed);
+			zone.m_total.store(0, std::memory_order_relaxed);
+		};
+		profile.m_startTicks = readProfileClock();
+		profile.m_startTime = std::chrono::steady_clock::now();
+	};
+
+	// Clock ticks per second, measured against steady_clock since the last
+	// reset; a very short interval is stretched to 10 ms first
+	double getProfileClockRate() {
+		ProfileRegistry& profile = registry();
+		auto minimum = profile.m_startTime + std::chrono::milliseconds(10);
+		if (std::chrono::steady_clock::now() < minimum) std::this_thread::sleep_until(minimum);
+
+		uint64_t ticks = readProfileClock() - profile.m_startTicks;
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - profile.m_startTime).count();
+		return ticks / seconds;
+	};
+
+	void writeProfile(std::ostream& os) {
+		uint64_t end = readProfileClock();
+		double rate = getProfileClockRate();
+		double wall = (end - registry().m_startTicks) / rate;
+		std::vector<const ProfileZone*> zones = getProfileZones();
+
+		size_t width = 7;
+		for (const auto* zone : zones) width = std::max(width, std::strlen(zone->m_name));
+
+		OutputBuffer output(os);
+		output << "Phase Breakdown (";
+		output.writeFixed(wall * 1e3, 3) << " ms wall, nested zones overlap):\n";
+		output.writeLeft("Zone", width).writeRight("Calls", 12).writeRight("Total ms", 14)
+			.writeRight("Mean us", 12).writeRight("% wall", 9) << "\n";
+		for (const auto* zone : zones) {
+			if (!zone->m_timed) continue;
+			uint64_t calls = read(zone->m_calls);
+			double seconds = read(zone->m_total) / rate;
+			output.writeLeft(zone->m_name, width).writeRight(calls, 12).writeFixed(seconds * 1e3, 3, 14)
+				.writeFixed(calls == 0 ? 0.0 : seconds * 1e6 / calls, 3, 12)
+				.writeFixed(wall > 0 ? seconds * 100 / wall : 0.0, 1, 8) << "%\n";
+		};
+
+		bool counters = false;
+		for (const auto* zone : zones) {
+			if (zone->m_timed) continue;
+			if (!counters) {
+				output << "\n";
+				output.writeLeft("Counter", width).writeRight("Events", 12).writeRight("Total", 14) << "\n";
+				counters = true;
+			}
+			output.writeLeft(zone->m_name, width).writeRight(read(zone->m_calls), 12).writeRight(read(zone->m_total), 14) << "\n";
+		};
+	};
+
+	void writeProfileAtExit() {
+		static bool s_registered = false;
+		if (s_registered) return;
+		s_registered = true;
+		registry();
+		std::atexit(writeProfileToStderr);
+	};
+}
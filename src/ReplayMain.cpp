@@ -0,0 +1,87 @@
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "EventLog.h"
+
+using namespace seneca;
+
+void displayUsage(const char* program) {
+    std::cerr << "Usage:\n";
+    std::cerr << "  " << program << " <log> [--at <iteration>]   state after an iteration (default: final state)\n";
+    std::cerr << "  " << program << " <log> --events             every event, one per line\n";
+    std::cerr << "  " << program << " --diff <log1> <log2>       first event where two runs differ\n";
+}
+
+std::ifstream openLog(const std::string& file) {
+    std::ifstream log(file, std::ios::binary);
+    if (!log) {
+        throw std::string("Unable to open ") + file;
+    }
+    return log;
+}
+
+int printEvents(const std::string& file) {
+    std::ifstream log = openLog(file);
+    EventLogReader reader(log);
+    LoggedEvent event;
+    while (reader.next(event)) {
+        std::cout << reader.describe(event) << "\n";
+    }
+    return 0;
+}
+
+// Exits 0 when both logs hold the same events, 1 at the first difference
+int diffLogs(const std::string& file1, const std::string& file2) {
+    std::ifstream log1 = openLog(file1);
+    std::ifstream log2 = openLog(file2);
+    EventLogReader reader1(log1);
+    EventLogReader reader2(log2);
+
+    LoggedEvent event1;
+    LoggedEvent event2;
+    for (size_t index = 1;; index++) {
+        bool more1 = reader1.next(event1);
+        bool more2 = reader2.next(event2);
+        if (!more1 && !more2) {
+            std::cout << "Logs are identical (" << index - 1 << " events)\n";
+            return 0;
+        }
+        if (more1 != more2 || event1 != event2
+            || reader1.describe(event1) != reader2.describe(event2)) {
+            std::cout << "Logs differ at event " << index << ":\n";
+            std::cout << "< " << (more1 ? reader1.describe(event1) : "(end of log)") << "\n";
+            std::cout << "> " << (more2 ? reader2.describe(event2) : "(end of log)") << "\n";
+            return 1;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc == 4 && std::string(argv[1]) == "--diff") {
+            return diffLogs(argv[2], argv[3]);
+        }
+        if (argc == 3 && std::string(argv[2]) == "--events") {
+            return printEvents(argv[1]);
+        }
+        if (argc == 2 || (argc == 4 && std::string(argv[2]) == "--at")) {
+            size_t iteration = argc == 4 ? std::stoul(argv[3]) : std::numeric_limits<size_t>::max();
+            std::ifstream log = openLog(argv[1]);
+            ReplayState::replay(log, iteration).display(std::cout);
+            return 0;
+        }
+    }
+    catch (const std::string& msg) {
+        std::cerr << "Error: " << msg << std::endl;
+        return 2;
+    }
+    catch (const std::logic_error&) {
+        std::cerr << "Error: invalid iteration number" << std::endl;
+        return 2;
+    }
+
+    displayUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,128 @@
+#include "ReportWriter.h"
+
+namespace seneca {
+	ReportFormat parseReportFormat(const std::string& name) {
+		if (name == "csv") return ReportFormat::Csv;
+		if (name == "jsonl") return ReportFormat::JsonLines;
+		throw std::string("Unknown report format: ") + name + " (expected csv or jsonl)";
+	};
+
+	ReportFormat getReportFormat(const std::string& file) {
+		size_t dot = file.find_last_of('.');
+		std::string extension = dot == std::string::npos ? "" : file.substr(dot + 1);
+		if (extension == "csv") return ReportFormat::Csv;
+		if (extension == "jsonl" || extension == "ndjson") return ReportFormat::JsonLines;
+		throw std::string("Report file must end in .csv or .jsonl: ") + file;
+	};
+
+	ReportWriter::ReportWriter(std::ostream& os, ReportFormat format) : m_output(os), m_format(format) {
+		if (m_format == ReportFormat::Csv) m_output << "record,id,name,product,item,serial,filled,quantity,description\n";
+	};
+
+	// Quoted only when it has to be, with quotes doubled (RFC 4180)
+	void ReportWriter::writeCsvField(const std::string& text) {
+		bool quoted = false;
+		for (char ch : text) {
+			if (ch == ',' || ch == '"' || ch == '\n' || ch == '\r') {
+				quoted = true;
+				break;
+			};
+		};
+		if (!quoted) {
+			m_output << text;
+			return;
+		};
+		m_output << '"';
+		for (char ch : text) {
+			if (ch == '"') m_output << '"';
+			m_output << ch;
+		};
+		m_output << '"';
+	};
+
+	void ReportWriter::writeJsonString(const std::string& text) {
+		static const char hex[] = "0123456789abcdef";
+		m_output << '"';
+		for (char ch : text) {
+			if (ch == '"' || ch == '\\') {
+				m_output << '\\' << ch;
+			} else if (static_cast<unsigned char>(ch) < 0x20) {
+				m_output << "\\u00" << hex[(ch >> 4) & 0xF] << hex[ch & 0xF];
+			} else {
+				m_output << ch;
+			};
+		};
+		m_output << '"';
+	};
+
+	void ReportWriter::writeOrder(const CustomerOrder& order, bool completed) {
+		const char* record = completed ? "completed" : "incomplete";
+
+		if (m_format == ReportFormat::Csv) {
+			// An order with no items still gets a row, with the item columns empty
+			if (order.getItemCount() == 0) {
+				m_output << record << ',' << order.getId() << ',';
+				writeCsvField(order.getName());
+				m_output << ',';
+				writeCsvField(order.getProduct());
+				m_output << ",,,,,\n";
+			};
+			for (size_t i = 0; i < order.getItemCount(); i++) {
+				m_output << record << ',' << order.getId() << ',';
+				writeCsvField(order.getName());
+				m_output << ',';
+				writeCsvField(order.getProduct());
+				m_output << ',';
+				writeCsvField(order.getItemName(i));
+				m_output << ',';
+				if (order.isItemFilledAt(i)) m_output << order.getItemSerialNumber(i) << ",1,,\n";
+				else m_output << ",0,,\n";
+			};
+			return;
+		};
+
+		m_output << "{\"record\":\"" << record << "\",\"id\":" << order.getId() << ",\"name\":";
+		writeJsonString(order.getName());
+		m_output << ",\"product\":";
+		writeJsonString(order.getProduct());
+		m_output << ",\"items\":[";
+		for (size_t i = 0; i < order.getItemCount(); i++) {
+			m_output << (i > 0 ? ",{\"item\":" : "{\"item\":");
+			writeJsonString(order.getItemName(i));
+			if (order.isItemFilledAt(i)) m_output << ",\"serial\":" << order.getItemSerialNumber(i) << ",\"filled\":true}";
+			else m_output << ",\"serial\":null,\"filled\":false}";
+		};
+		m_output << "],\"missing\":[";
+		bool first = true;
+		for (size_t i = 0; i < order.getItemCount(); i++) {
+			if (order.isItemFilledAt(i)) continue;
+			if (!first) m_output << ',';
+			writeJsonString(order.getItemName(i));
+			first = false;
+		};
+		m_output << "]}\n";
+	};
+
+	void ReportWriter::writeStation(const Station& station) {
+		size_t id = static_cast<size_t>(station.getId());
+
+		if (m_format == ReportFormat::Csv) {
+			m_output << "station," << id << ',';
+			writeCsvField(station.getItemName());
+			m_output << ",,," << station.getSerialNumber() << ",," << station.getQuantity() << ',';
+			writeCsvField(station.getDescription());
+			m_output << '\n';
+			return;
+		};
+
+		m_output << "{\"record\":\"station\",\"id\":" << id << ",\"name\":";
+		writeJsonString(station.getItemName());
+		m_output << ",\"serial\":" << station.getSerialNumber() << ",\"quantity\":" << station.getQuantity() << ",\"description\":";
+		writeJsonString(station.getDescription());
+		m_output << "}\n";
+	};
+
+	void ReportWriter::flush() {
+		m_output.flush();
+	};
+}
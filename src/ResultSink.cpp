@@ -0,0 +1,52 @@
+#include "BinaryIO.h"
+#include "ResultSink.h"
+
+namespace seneca {
+	namespace {
+		const std::string c_magic = "FALSIM-SPILL";
+		const uint64_t c_version = 1;
+	}
+
+	SpillFileSink::SpillFileSink(const std::string& file) : m_file(file), m_os(file, std::ios::binary | std::ios::trunc) {
+		if (!m_os) throw std::string("Unable to open ") + file;
+		writeBinary(m_os, c_magic);
+		writeBinary(m_os, c_version);
+	};
+
+	void SpillFileSink::accept(CustomerOrder&& order, bool completed) {
+		writeBinary(m_os, completed ? 1 : 0);
+		order.saveState(m_os);
+		if (!m_os) throw std::string("Unable to write ") + m_file;
+		(completed ? m_completed : m_incomplete)++;
+	};
+
+	size_t SpillFileSink::getCompletedCount() const {
+		return m_completed;
+	};
+
+	size_t SpillFileSink::getIncompleteCount() const {
+		return m_incomplete;
+	};
+
+	void SpillFileSink::flush() {
+		m_os.flush();
+		if (!m_os) throw std::string("Unable to write ") + m_file;
+	};
+
+	const std::string& SpillFileSink::getFile() const {
+		return m_file;
+	};
+
+	SpillFileReader::SpillFileReader(const std::string& file) : m_is(file, std::ios::binary) {
+		if (!m_is) throw std::string("Unable to open ") + file;
+		if (readBinaryString(m_is) != c_magic) throw std::string("Not a spill file: ") + file;
+		if (readBinary(m_is) != c_version) throw std::string("Unsupported spill file version: ") + file;
+	};
+
+	bool SpillFileReader::next(CustomerOrder& order, bool& completed) {
+		if (m_is.peek() == std::char_traits<char>::eof()) return false;
+		completed = readBinary(m_is) != 0;
+		order.loadState(m_is);
+		return true;
+	};
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include "LineManager.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "Scenario.h"
+#include "Utilities.h"
+#include "Workstation.h"
+
+namespace seneca {
+	namespace {
+		// Restores the shared Utilities delimiter when a load finishes or throws
+		class DelimiterGuard {
+			char m_original;
+		public:
+			DelimiterGuard(char delimiter) : m_original(Utilities::getDelimiter()) {
+				Utilities::setDelimiter(delimiter);
+			};
+			~DelimiterGuard() {
+				Utilities::setDelimiter(m_original);
+			};
+		};
+
+		// Measures the width one load sets on a shared width field, then
+		// leaves the field as wide as it would have been without the scope
+		class WidthScope {
+			size_t (*m_get)();
+			void (*m_set)(size_t);
+			size_t m_original;
+		public:
+			WidthScope(size_t (*get)(), void (*set)(size_t)) : m_get(get), m_set(set), m_original(get()) {
+				m_set(0);
+			};
+			~WidthScope() {
+				m_set(std::max(m_original, m_get()));
+			};
+			size_t getWidth() const {
+				return m_get();
+			};
+		};
+	}
+
+	void Scenario::numberStations() {
+		for (size_t i = 0; i < m_stations.size(); i++) {
+			m_stations[i].setId(static_cast<int>(i + 1));
+		};
+	};
+
+	void Scenario::loadStations(const std::string& file, char delimiter) {
+		SENECA_PROFILE_ZONE("load.stations");
+		std::ifstream ifile(file);
+		if (!ifile) throw std::string("Unable to open ") + file;
+
+		DelimiterGuard guard(delimiter);
+		WidthScope width(Station::getStaticWidthField, Station::setStaticWidthField);
+		std::string record;
+		while (std::getline(ifile, record)) {
+			if (!record.empty()) m_stations.emplace_back(record);
+		};
+		m_stationWidth = std::max(m_stationWidth, width.getWidth());
+		numberStations();
+	};
+
+	void Scenario::loadOrders(const std::string& file, char delimiter) {
+		SENECA_PROFILE_ZONE("load.orders");
+		std::ifstream ifile(file);
+		if (!ifile) throw std::string("Unable to open ") + file;
+
+		DelimiterGuard guard(delimiter);
+		WidthScope width(CustomerOrder::getWidthField, CustomerOrder::setWidthField);
+		std::string record;
+		while (std::getline(ifile, record)) {
+			if (!record.empty()) m_orders.emplace_back(record);
+		};
+		m_orderWidth = std::max(m_orderWidth, width.getWidth());
+	};
+
+	// Resolves the linked pairs of an assembly line file into the station sequence
+	// an order actually travels, using the same rules as LineManager.
+	void Scenario::loadLine(const std::string& file, char delimiter) {
+		SENECA_PROFILE_ZONE("load.line");
+		std::vector<std::unique_ptr<Workstation>> stations;
+		std::vector<Workstation*> pointers;
+		{
+			SENECA_MEMORY_TAG(StationStrings);
+			for (const auto& station : m_stations) {
+				stations.push_back(std::make_unique<Workstation>(station));
+				pointers.push_back(stations.back().get());
+			};
+		}
+
+		DelimiterGuard guard(delimiter);
+		LineManager manager(file, pointers);
+		manager.reorderStations();
+
+		m_line.clear();
+		for (const auto* station : manager.getActiveLine()) {
+			m_line.push_back(station->getItemName());
+		};
+	};
+
+	void Scenario::setLine(const std::vector<std::string>& line) {
+		for (const auto& name : line) {
+			if (!findStation(name)) throw std::string("Unknown station in line: ") + name;
+		};
+		m_line = line;
+	};
+
+	void Scenario::addStations(const std::vector<Station>& stations) {
+		SENECA_MEMORY_TAG(StationStrings);
+		m_stations.insert(m_stations.end(), stations.begin(), stations.end());
+		m_stationWidth = std::max(m_stationWidth, Station::getStaticWidthField());
+		numberStations();
+	};
+
+	void Scenario::addOrders(const std::vector<CustomerOrder>& orders) {
+		for (const auto& order : orders) {
+			m_orders.push_back(order.clone());
+		};
+		m_orderWidth = std::max(m_orderWidth, CustomerOrder::getWidthField());
+	};
+
+	void Scenario::addStations(const Scenario& other) {
+		SENECA_MEMORY_TAG(StationStrings);
+		m_stations.insert(m_stations.end(), other.m_stations.begin(), other.m_stations.end());
+		m_stationWidth = std::max(m_stationWidth, other.m_stationWidth);
+		numberStations();
+	};
+
+	void Scenario::addOrders(const Scenario& other) {
+		for (const auto& order : other.m_orders) {
+			m_orders.push_back(order.clone());
+		};
+		m_orderWidth = std::max(m_orderWidth, other.m_orderWidth);
+	};
+
+	const std::vector<Station>& Scenario::getStations() const {
+		return m_stations;
+	};
+
+	const std::vector<CustomerOrder>& Scenario::getOrders() const {
+		return m_orders;
+	};
+
+	const std::vector<std::string>& Scenario::getLine() const {
+		return m_line;
+	};
+
+	size_t Scenario::getStationWidth() const {
+		return m_stationWidth;
+	};
+
+	size_t Scenario::getOrderWidth() const {
+		return m_orderWidth;
+	};
+
+	const Station* Scenario::findStation(const std::string& itemName) const {
+		for (const auto& station : m_stations) {
+			if (station.getItemName() == itemName) return &station;
+		};
+		return nullptr;
+	};
+}
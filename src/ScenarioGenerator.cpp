@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cmath>
+#include "OutputBuffer.h"
+#include "ScenarioGenerator.h"
+
+namespace seneca {
+	namespace {
+		// Uniform in [0, 1) from the top 53 bits
+		double uniform(std::mt19937_64& random) {
+			return (random() >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+		void appendNumber(std::string& text, size_t value) {
+			char digits[20];
+			size_t size = 0;
+			do {
+				digits[sizeof(digits) - ++size] = static_cast<char>('0' + value % 10);
+				value /= 10;
+			} while (value > 0);
+			text.append(digits + sizeof(digits) - size, size);
+		}
+
+		// Uniform in [0, bound); a multiply and shift rather than a division
+		// for any bound that fits in 32 bits
+		size_t below(std::mt19937_64& random, size_t bound) {
+			if (bound <= UINT32_MAX) return static_cast<size_t>(((random() >> 32) * bound) >> 32);
+			return static_cast<size_t>(random() % bound);
+		}
+	}
+
+	ScenarioGenerator::ScenarioGenerator(const GeneratorSpec& spec) : m_spec(spec) {
+		if (m_spec.m_itemTypes == 0) throw std::string("A scenario needs at least one item type.");
+		if (m_spec.m_minItems == 0 || m_spec.m_minItems > m_spec.m_maxItems) throw std::string("Items per order must be a range like 1:5.");
+		if (m_spec.m_lineLength == 0 || m_spec.m_lineLength > m_spec.m_itemTypes) m_spec.m_lineLength = m_spec.m_itemTypes;
+
+		// Popularity follows the item's rank; the names carry no hint of it
+		m_items.reserve(m_spec.m_itemTypes);
+		std::vector<double> weights(m_spec.m_itemTypes);
+		double total = 0;
+		for (size_t i = 0; i < m_spec.m_itemTypes; i++) {
+			m_items.push_back("Item" + std::to_string(i + 1));
+			weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), m_spec.m_zipf);
+			total += weights[i];
+		};
+
+		double averageItems = (m_spec.m_minItems + m_spec.m_maxItems) / 2.0;
+		for (size_t i = 0; i < m_spec.m_itemTypes; i++) {
+			double demand = m_spec.m_orders * averageItems * weights[i] / total;
+			m_quantities.push_back(static_cast<size_t>(std::llround(demand * m_spec.m_stock)));
+		};
+
+		// Vose's construction: every slot holds its own share plus part of
+		// one heavier item, so a pick costs two draws whatever the skew
+		size_t count = m_spec.m_itemTypes;
+		m_keep.resize(count);
+		m_alias.resize(count);
+		std::vector<double> scaled(count);
+		std::vector<size_t> small, large;
+		for (size_t i = 0; i < count; i++) {
+			scaled[i] = weights[i] * count / total;
+			(scaled[i] < 1.0 ? small : large).push_back(i);
+		};
+		while (!small.empty() && !large.empty()) {
+			size_t light = small.back();
+			size_t heavy = large.back();
+			small.pop_back();
+			m_keep[light] = scaled[light];
+			m_alias[light] = heavy;
+			scaled[heavy] -= 1.0 - scaled[light];
+			if (scaled[heavy] < 1.0) {
+				large.pop_back();
+				small.push_back(heavy);
+			};
+		};
+		// Whatever is left is 1 up to rounding
+		for (size_t i : large) {
+			m_keep[i] = 1.0;
+			m_alias[i] = i;
+		};
+		for (size_t i : small) {
+			m_keep[i] = 1.0;
+			m_alias[i] = i;
+		};
+
+		// The line visits a random selection of the items in a random order
+		std::mt19937_64 random(m_spec.m_seed * 2);
+		std::vector<size_t> order(m_spec.m_itemTypes);
+		for (size_t i = 0; i < order.size(); i++) order[i] = i;
+		for (size_t i = order.size(); i > 1; i--) {
+			std::swap(order[i - 1], order[below(random, i)]);
+		};
+		for (size_t i = 0; i < m_spec.m_lineLength; i++) {
+			m_lineItems.push_back(order[i]);
+			m_line.push_back(m_items[order[i]]);
+		};
+	};
+
+	const GeneratorSpec& ScenarioGenerator::getSpec() const {
+		return m_spec;
+	};
+
+	const std::vector<std::string>& ScenarioGenerator::getItems() const {
+		return m_items;
+	};
+
+	const std::vector<std::string>& ScenarioGenerator::getLine() const {
+		return m_line;
+	};
+
+	const std::vector<size_t>& ScenarioGenerator::getLineItems() const {
+		return m_lineItems;
+	};
+
+	std::string ScenarioGenerator::getStationRecord(size_t index, char delimiter) const {
+		return m_items[index] + delimiter + std::to_string(100000 + index * 1000) + delimiter
+			+ std::to_string(m_quantities[index]) + delimiter + "Synthetic item " + std::to_string(index + 1);
+	};
+
+	void ScenarioGenerator::writeStations(std::ostream& os, size_t first, size_t last, char delimiter) const {
+		OutputBuffer output(os, 1 << 20);
+		for (size_t i = first; i < last && i < m_items.size(); i++) {
+			output << getStationRecord(i, delimiter) << '\n';
+		};
+	};
+
+	void ScenarioGenerator::writeLine(std::ostream& os) const {
+		OutputBuffer output(os, 1 << 20);
+		for (size_t i = 0; i < m_line.size(); i++) {
+			output << m_line[i];
+			if (i + 1 < m_line.size()) output << '|' << m_line[i + 1];
+			output << '\n';
+		};
+	};
+
+	void ScenarioGenerator::writeOrders(std::ostream& os) const {
+		OutputBuffer output(os, 1 << 20);
+		forEachOrder([&](const std::string& record) {
+			output << record << '\n';
+		});
+	};
+
+	size_t ScenarioGenerator::pickItem(std::mt19937_64& random) const {
+		size_t slot = below(random, m_keep.size());
+		return uniform(random) < m_keep[slot] ? slot : m_alias[slot];
+	};
+
+	void ScenarioGenerator::appendOrder(std::string& record, size_t index, std::mt19937_64& random) const {
+		record += "Customer ";
+		appendNumber(record, index + 1);
+		record += "|Product ";
+		appendNumber(record, index % 97 + 1);
+
+		size_t count = m_spec.m_minItems + below(random, m_spec.m_maxItems - m_spec.m_minItems + 1);
+		for (size_t i = 0; i < count; i++) {
+			record += '|';
+			record += m_items[pickItem(random)];
+		};
+	};
+}
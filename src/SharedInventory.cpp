@@ -0,0 +1,219 @@
+#include <algorithm>
+#include "OutputBuffer.h"
+#include "Parallel.h"
+#include "SharedInventory.h"
+
+namespace seneca {
+	InventoryFairness parseInventoryFairness(const std::string& name) {
+		if (name == "first-come") return InventoryFairness::FirstCome;
+		if (name == "equal-share") return InventoryFairness::EqualShare;
+		throw std::string("Unknown fairness: ") + name + " (expected first-come or equal-share)";
+	};
+
+	SharedInventory::SharedInventory(const std::vector<Station>& stock, size_t lines, InventoryFairness fairness) : m_fairness(fairness), m_lines(lines) {
+		if (m_lines == 0) throw std::string("A shared inventory needs at least one line.");
+		for (const auto& station : stock) {
+			auto item = std::make_unique<Item>();
+			item->m_name = station.getItemName();
+			item->m_serialNumber = station.getSerialNumber();
+			item->m_shares = std::make_unique<std::atomic<size_t>[]>(m_lines);
+
+			size_t share = m_fairness == InventoryFairness::EqualShare ? station.getQuantity() / m_lines : 0;
+			for (size_t line = 0; line < m_lines; line++) {
+				item->m_shares[line] = share;
+			};
+			item->m_common = station.getQuantity() - share * m_lines;
+			m_items.push_back(std::move(item));
+		};
+		m_contention.assign(m_lines, std::vector<InventoryContention>(m_items.size()));
+	};
+
+	InventoryFairness SharedInventory::getFairness() const {
+		return m_fairness;
+	};
+
+	size_t SharedInventory::getLineCount() const {
+		return m_lines;
+	};
+
+	size_t SharedInventory::getItemCount() const {
+		return m_items.size();
+	};
+
+	const std::string& SharedInventory::getItemName(size_t item) const {
+		return m_items[item]->m_name;
+	};
+
+	size_t SharedInventory::indexOf(const std::string& itemName) const {
+		for (size_t i = 0; i < m_items.size(); i++) {
+			if (m_items[i]->m_name == itemName) return i;
+		};
+		return m_items.size();
+	};
+
+	// Compare-and-swap on the common stock; every failed attempt means another
+	// line changed it first
+	size_t SharedInventory::takeCommon(Item& item, size_t count, InventoryContention& contention) {
+		size_t available = item.m_common.load(std::memory_order_relaxed);
+		while (true) {
+			size_t granted = std::min(count, available);
+			if (granted == 0) return 0;
+			if (item.m_common.compare_exchange_strong(available, available - granted, std::memory_order_relaxed)) return granted;
+			contention.m_retries++;
+		};
+	};
+
+	size_t SharedInventory::takeStock(size_t item, size_t line, size_t count) {
+		Item& entry = *m_items[item];
+		InventoryContention& contention = m_contention[line][item];
+		contention.m_requests++;
+		contention.m_wanted += count;
+
+		// Only the owning line takes from its share, so a plain load and store will do
+		size_t granted = 0;
+		if (m_fairness == InventoryFairness::EqualShare) {
+			size_t own = entry.m_shares[line].load(std::memory_order_relaxed);
+			granted = std::min(count, own);
+			entry.m_shares[line].store(own - granted, std::memory_order_relaxed);
+		};
+		if (granted < count) {
+			size_t common = takeCommon(entry, count - granted, contention);
+			if (m_fairness == InventoryFairness::EqualShare) contention.m_fromPool += common;
+			granted += common;
+		};
+
+		contention.m_granted += granted;
+		if (granted < count) contention.m_shortfalls++;
+		return granted;
+	};
+
+	size_t SharedInventory::takeSerialNumbers(size_t item, size_t count) {
+		return m_items[item]->m_serialNumber.fetch_add(count, std::memory_order_relaxed);
+	};
+
+	StationReservation SharedInventory::reserve(size_t item, size_t line, size_t count) {
+		size_t granted = takeStock(item, line, count);
+		if (granted == 0) return StationReservation{ getSerialNumber(item), 0 };
+		return StationReservation{ takeSerialNumbers(item, granted), granted };
+	};
+
+	size_t SharedInventory::getAvailable(size_t item, size_t line) const {
+		size_t available = m_items[item]->m_common.load(std::memory_order_relaxed);
+		if (m_fairness == InventoryFairness::EqualShare) available += m_items[item]->m_shares[line].load(std::memory_order_relaxed);
+		return available;
+	};
+
+	size_t SharedInventory::getQuantity(size_t item) const {
+		size_t quantity = m_items[item]->m_common.load(std::memory_order_relaxed);
+		for (size_t line = 0; line < m_lines; line++) {
+			quantity += m_items[item]->m_shares[line].load(std::memory_order_relaxed);
+		};
+		return quantity;
+	};
+
+	size_t SharedInventory::getSerialNumber(size_t item) const {
+		return m_items[item]->m_serialNumber.load(std::memory_order_relaxed);
+	};
+
+	void SharedInventory::finishLine(size_t line) {
+		for (auto& item : m_items) {
+			item->m_common.fetch_add(item->m_shares[line].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		};
+	};
+
+	const InventoryContention& SharedInventory::getContention(size_t line, size_t item) const {
+		return m_contention[line][item];
+	};
+
+	void SharedInventory::writeContention(std::ostream& os, size_t line) const {
+		size_t width = 4;
+		for (const auto& item : m_items) {
+			width = std::max(width, item->m_name.size());
+		};
+
+		OutputBuffer output(os);
+		output.writeLeft("Item", width) << " | Requests |   Wanted |  Granted |    Short |  Retries | From pool\n";
+		for (size_t i = 0; i < m_items.size(); i++) {
+			const InventoryContention& contention = m_contention[line][i];
+			if (contention.m_requests == 0) continue;
+			output.writeLeft(m_items[i]->m_name, width) << " | ";
+			output.writeRight(contention.m_requests, 8) << " | ";
+			output.writeRight(contention.m_wanted, 8) << " | ";
+			output.writeRight(contention.m_granted, 8) << " | ";
+			output.writeRight(contention.m_shortfalls, 8) << " | ";
+			output.writeRight(contention.m_retries, 8) << " | ";
+			output.writeRight(contention.m_fromPool, 9) << '\n';
+		};
+	};
+
+	SharedLineRunner::SharedLineRunner(const Scenario& stock, InventoryFairness fairness) : m_stock(stock.getStations()), m_fairness(fairness) {};
+
+	void SharedLineRunner::addLine(const std::string& name, const Scenario& line) {
+		if (m_inventory) throw std::string("Lines cannot be added after the run.");
+		m_names.push_back(name);
+		m_lines.push_back(std::make_unique<SimulationContext>(line));
+	};
+
+	std::vector<SimulationResult> SharedLineRunner::run() {
+		if (m_inventory) throw std::string("Shared lines have already run.");
+		m_inventory = std::make_unique<SharedInventory>(m_stock, m_lines.size(), m_fairness);
+		for (size_t line = 0; line < m_lines.size(); line++) {
+			for (const auto& station : m_lines[line]->getStations()) {
+				station->drawFrom(m_inventory.get(), line);
+			};
+		};
+
+		// Every line gets a thread of its own, so they really do run side by side
+		std::vector<SimulationResult> results(m_lines.size());
+		parallelFor(m_lines.size(), m_lines.size(), [&](size_t line) {
+			std::ostream discard(nullptr);
+			results[line] = m_lines[line]->run(discard);
+			m_inventory->finishLine(line);
+		});
+		return results;
+	};
+
+	size_t SharedLineRunner::getLineCount() const {
+		return m_lines.size();
+	};
+
+	const std::string& SharedLineRunner::getLineName(size_t line) const {
+		return m_names[line];
+	};
+
+	const SimulationContext& SharedLineRunner::getLine(size_t line) const {
+		return *m_lines[line];
+	};
+
+	const SharedInventory& SharedLineRunner::getInventory() const {
+		if (!m_inventory) throw std::string("Shared lines have not run yet.");
+		return *m_inventory;
+	};
+
+	void SharedLineRunner::writeReport(std::ostream& os) const {
+		const SharedInventory& inventory = getInventory();
+		for (size_t line = 0; line < m_lines.size(); line++) {
+			const SimulationResult& result = m_lines[line]->getResult();
+			{
+				OutputBuffer output(os);
+				output << "Line " << m_names[line] << ": " << result.m_completed << " completed, " << result.m_incomplete
+					<< " incomplete in " << result.m_iterations << " iterations\n";
+			}
+			inventory.writeContention(os, line);
+			os << "\n";
+		};
+
+		size_t width = 0;
+		for (size_t item = 0; item < inventory.getItemCount(); item++) {
+			width = std::max(width, inventory.getItemName(item).size());
+		};
+
+		OutputBuffer output(os);
+		output << "Shared Inventory (" << (m_fairness == InventoryFairness::EqualShare ? "equal-share" : "first-come") << "):\n";
+		for (size_t item = 0; item < inventory.getItemCount(); item++) {
+			output.writeLeft(inventory.getItemName(item), width) << " | ";
+			output.writeRight(inventory.getSerialNumber(item), 6, '0') << " | ";
+			output.writeRight(inventory.getQuantity(item), 4) << '\n';
+		};
+	};
+}
@@ -0,0 +1,117 @@
+#include <utility>
+#include "FastForward.h"
+#include "LineManager.h"
+#include "MemoryTracker.h"
+#include "SimulationContext.h"
+
+namespace seneca {
+	namespace {
+		// Lends the calling thread's global queues to a context for the duration
+		// of a run and hands the caller's own queues back afterwards.
+		class QueueSwap {
+			std::deque<CustomerOrder> m_pending;
+			std::deque<CustomerOrder> m_completed;
+			std::deque<CustomerOrder> m_incomplete;
+		public:
+			QueueSwap() {
+				g_pending.swap(m_pending);
+				g_completed.swap(m_completed);
+				g_incomplete.swap(m_incomplete);
+			};
+			~QueueSwap() {
+				g_pending.swap(m_pending);
+				g_completed.swap(m_completed);
+				g_incomplete.swap(m_incomplete);
+			};
+		};
+	}
+
+	SimulationContext::SimulationContext(const Scenario& scenario) : SimulationContext(scenario, scenario.getLine(), InventoryOverlay()) {};
+
+	SimulationContext::SimulationContext(const Scenario& scenario, const std::vector<std::string>& line) : SimulationContext(scenario, line, InventoryOverlay()) {};
+
+	SimulationContext::SimulationContext(const Scenario& scenario, const InventoryOverlay& overlay) : SimulationContext(scenario, scenario.getLine(), overlay) {};
+
+	SimulationContext::SimulationContext(const Scenario& scenario, const std::vector<std::string>& line, const InventoryOverlay& overlay) {
+		{
+			SENECA_MEMORY_TAG(StationStrings);
+			for (const auto& station : scenario.getStations()) {
+				m_stations.push_back(std::make_unique<Workstation>(station));
+			};
+		}
+
+		for (const auto& entry : overlay) {
+			Workstation* station = findStation(entry.first);
+			if (!station) throw std::string("Unknown station in inventory overlay: ") + entry.first;
+			station->setQuantity(entry.second);
+		};
+
+		for (const auto& name : line) {
+			Workstation* station = findStation(name);
+			if (!station) throw std::string("Unknown station in line: ") + name;
+			m_line.push_back(station);
+		};
+
+		for (const auto& order : scenario.getOrders()) {
+			m_orders.push_back(order.clone());
+		};
+
+		if (m_line.empty() && !m_orders.empty()) throw std::string("Scenario has orders but no assembly line.");
+	};
+
+	// Ticks LineManager::run to completion, logging to `os`
+	SimulationResult SimulationContext::run(std::ostream& os) {
+		return simulate(&os);
+	};
+
+	// Same result as run, computed by the fast-forward engine without logging
+	SimulationResult SimulationContext::fastForward() {
+		return simulate(nullptr);
+	};
+
+	SimulationResult SimulationContext::simulate(std::ostream* os) {
+		QueueSwap swap;
+		g_pending = std::move(m_orders);
+		m_orders.clear();
+
+		LineManager manager(m_line);
+		if (os) {
+			while (!manager.run(*os));
+			m_result.m_iterations = manager.getIterationCount();
+		} else {
+			m_result.m_iterations = seneca::fastForward(m_line);
+		};
+
+		m_completed = std::move(g_completed);
+		m_incomplete = std::move(g_incomplete);
+		g_completed.clear();
+		g_incomplete.clear();
+
+		m_result.m_completed = m_completed.size();
+		m_result.m_incomplete = m_incomplete.size();
+		return m_result;
+	};
+
+	const SimulationResult& SimulationContext::getResult() const {
+		return m_result;
+	};
+
+	const std::deque<CustomerOrder>& SimulationContext::getCompleted() const {
+		return m_completed;
+	};
+
+	const std::deque<CustomerOrder>& SimulationContext::getIncomplete() const {
+		return m_incomplete;
+	};
+
+	const std::vector<std::unique_ptr<Workstation>>& SimulationContext::getStations() const {
+		return m_stations;
+	};
+
+	Workstation* SimulationContext::findStation(const std::string& itemName) const {
+		for (const auto& station : m_stations) {
+			if (station->getItemName() == itemName) return station.get();
+		};
+		return nullptr;
+	};
+}
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include "FactoryCore.h"
+#include "InventorySweep.h"
+#include "SimulationContext.h"
+#include "SimulationServer.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SENECA_HAS_UNIX_SOCKETS 1
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace seneca {
+	namespace {
+		void requireWords(const std::vector<std::string>& words, size_t minimum, const char* usage) {
+			if (words.size() < minimum) throw std::string("Usage: ") + usage;
+		};
+
+		// One line per order and station after the counts, so a client can read
+		// the reply without knowing the column widths
+		std::string describeRun(const SimulationContext& context, const SimulationResult& result) {
+			std::ostringstream os;
+			os << "result " << result.m_completed << " " << result.m_incomplete << " " << result.m_iterations << "\n";
+			for (const auto& order : context.getCompleted()) {
+				os << "completed " << order.getId() << " " << order.getName() << ", " << order.getProduct() << "\n";
+			};
+			for (const auto& order : context.getIncomplete()) {
+				os << "incomplete " << order.getId() << " " << order.getName() << ", " << order.getProduct() << "\n";
+			};
+			for (const auto& station : context.getStations()) {
+				os << "station " << station->getQuantity() << " " << station->getItemName() << "\n";
+			};
+			return os.str();
+		};
+	}
+
+	SimulationServer::SimulationServer(size_t workers) : m_pool(workers) {};
+
+	SimulationServer::~SimulationServer() {
+		stop();
+	};
+
+	std::vector<std::string> SimulationServer::splitRequest(const std::string& request) {
+		std::vector<std::string> words;
+		size_t i = 0;
+		while (i < request.size()) {
+			if (request[i] == ' ' || request[i] == '\t' || request[i] == '\r') {
+				i++;
+				continue;
+			};
+
+			std::string word;
+			if (request[i] == '"') {
+				size_t close = request.find('"', i + 1);
+				if (close == std::string::npos) throw std::string("Unterminated quote in request");
+				word = request.substr(i + 1, close - i - 1);
+				i = close + 1;
+			} else {
+				while (i < request.size() && request[i] != ' ' && request[i] != '\t' && request[i] != '\r') {
+					word += request[i++];
+				};
+			};
+			words.push_back(word);
+		};
+		return words;
+	};
+
+	std::shared_ptr<const Scenario> SimulationServer::findScenario(const std::string& name) {
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto it = m_scenarios.find(name);
+		if (it == m_scenarios.end()) throw std::string("Unknown scenario: ") + name;
+		return it->second;
+	};
+
+	std::shared_ptr<SimulationServer::Job> SimulationServer::findJob(const std::string& id) {
+		size_t number = 0;
+		try {
+			number = std::stoul(id);
+		} catch (const std::logic_error&) {
+			throw std::string("Invalid job id: ") + id;
+		};
+
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto it = m_jobs.find(number);
+		if (it == m_jobs.end()) throw std::string("Unknown job: ") + id;
+		return it->second;
+	};
+
+	std::string SimulationServer::submit(std::function<std::string()> work) {
+		auto job = std::make_shared<Job>();
+		size_t id = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			id = m_nextJob++;
+			m_jobs[id] = job;
+		}
+
+		m_pool.submit([this, job, work]() {
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				job->m_status = "running";
+			}
+			std::string status = "done";
+			std::string output;
+			try {
+				output = work();
+			} catch (const std::string& msg) {
+				status = "failed";
+				output = msg;
+			} catch (const std::exception& e) {
+				status = "failed";
+				output = e.what();
+			};
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				job->m_status = status;
+				job->m_output = std::move(output);
+			}
+			m_jobFinished.notify_all();
+		});
+
+		return "job " + std::to_string(id) + "\n";
+	};
+
+	std::string SimulationServer::handle(const std::string& request) {
+		try {
+			std::vector<std::string> words = splitRequest(request);
+			if (words.empty()) throw std::string("Empty request");
+			const std::string& command = words[0];
+			std::string body;
+
+			if (command == "load") {
+				requireWords(words, 6, "load <name> <stations1> <stations2> <orders> <line>");
+				std::shared_ptr<const Scenario> scenario;
+				{
+					std::lock_guard<std::mutex> lock(m_loadLock);
+					scenario = std::make_shared<const Scenario>(loadScenario(words[2], words[3], words[4], words[5]));
+				}
+				{
+					std::lock_guard<std::mutex> lock(m_lock);
+					m_scenarios[words[1]] = scenario;
+				}
+				body = "loaded " + words[1] + ": " + std::to_string(scenario->getStations().size()) + " stations, "
+					+ std::to_string(scenario->getOrders().size()) + " orders\n";
+			}
+			else if (command == "unload") {
+				requireWords(words, 2, "unload <name>");
+				std::lock_guard<std::mutex> lock(m_lock);
+				if (m_scenarios.erase(words[1]) == 0) throw std::string("Unknown scenario: ") + words[1];
+				body = "unloaded " + words[1] + "\n";
+			}
+			else if (command == "scenarios") {
+				std::lock_guard<std::mutex> lock(m_lock);
+				for (const auto& entry : m_scenarios) {
+					body += entry.first + "\n";
+				};
+			}
+			else if (command == "run") {
+				requireWords(words, 2, "run <name> [Station=quantity]...");
+				std::shared_ptr<const Scenario> scenario = findScenario(words[1]);
+				InventoryOverlay overlay;
+				for (size_t i = 2; i < words.size(); i++) {
+					size_t equals = words[i].find('=');
+					if (equals == std::string::npos) throw std::string("Invalid quantity: ") + words[i];
+					std::string station = words[i].substr(0, equals);
+					if (!scenario->findStation(station)) throw std::string("Unknown station: ") + station;
+					try {
+						overlay[station] = std::stoul(words[i].substr(equals + 1));
+					} catch (const std::logic_error&) {
+						throw std::string("Invalid quantity: ") + words[i];
+					};
+				};
+
+				body = submit([scenario, overlay]() {
+					SimulationContext context(*scenario, overlay);
+					SimulationResult result = context.fastForward();
+					return describeRun(context, result);
+				});
+			}
+			else if (command == "sweep") {
+				requireWords(words, 3, "sweep <name> <Station=from:to[:step]|Station=q1,q2,...>...");
+				std::shared_ptr<const Scenario> scenario = findScenario(words[1]);
+				std::vector<SweepAxis> axes;
+				{
+					// Validates the axes before the job is queued
+					InventorySweep sweep(*scenario);
+					for (size_t i = 2; i < words.size(); i++) {
+						axes.push_back(InventorySweep::parseAxis(words[i]));
+						sweep.addAxis(axes.back());
+					};
+				}
+
+				// The pool already runs jobs side by side, so each sweep keeps to its worker
+				body = submit([scenario, axes]() {
+					InventorySweep sweep(*scenario, 1);
+					for (const auto& axis : axes) sweep.addAxis(axis);
+					std::ostringstream os;
+					sweep.writeTable(os, sweep.run());
+					return os.str();
+				});
+			}
+			else if (command == "status") {
+				requireWords(words, 2, "status <id>");
+				std::shared_ptr<Job> job = findJob(words[1]);
+				std::lock_guard<std::mutex> lock(m_lock);
+				body = job->m_status + "\n";
+			}
+			else if (command == "result") {
+				requireWords(words, 2, "result <id>");
+				std::shared_ptr<Job> job = findJob(words[1]);
+				std::unique_lock<std::mutex> lock(m_lock);
+				m_jobFinished.wait(lock, [&]() { return job->m_status == "done" || job->m_status == "failed"; });
+				if (job->m_status == "failed") throw std::string("Job ") + words[1] + " failed: " + job->m_output;
+				body = job->m_output;
+			}
+			else if (command == "forget") {
+				requireWords(words, 2, "forget <id>");
+				findJob(words[1]);
+				std::lock_guard<std::mutex> lock(m_lock);
+				m_jobs.erase(std::stoul(words[1]));
+				body = "forgot " + words[1] + "\n";
+			}
+			else if (command == "shutdown") {
+				stop();
+				body = "stopping\n";
+			}
+			else {
+				throw std::string("Unknown request: ") + command;
+			};
+
+			return "ok " + std::to_string(body.size()) + "\n" + body;
+		} catch (const std::string& msg) {
+			return "error " + msg + "\n";
+		} catch (const std::exception& e) {
+			return "error " + std::string(e.what()) + "\n";
+		};
+	};
+
+	void SimulationServer::stop() {
+		m_stopping = true;
+#ifdef SENECA_HAS_UNIX_SOCKETS
+		// Wakes the accept in serve; the listener is closed there
+		int listener = m_listener.load();
+		if (listener >= 0) ::shutdown(listener, SHUT_RDWR);
+#endif
+	};
+
+	bool SimulationServer::isStopping() const {
+		return m_stopping;
+	};
+
+	size_t SimulationServer::getConnectionCount() const {
+		std::lock_guard<std::mutex> lock(m_clientLock);
+		return m_connections.size();
+	};
+
+	// The caller holds m_clientLock. A finished connection has nothing left to
+	// do after recording itself, so joining it does not wait on the lock.
+	void SimulationServer::reapConnections() {
+		for (auto id : m_finished) {
+			auto connection = std::find_if(m_connections.begin(), m_connections.end(),
+				[&](const std::thread& thread) { return thread.get_id() == id; });
+			if (connection == m_connections.end()) continue;
+			connection->join();
+			m_connections.erase(connection);
+		};
+		m_finished.clear();
+	};
+
+#ifdef SENECA_HAS_UNIX_SOCKETS
+	void SimulationServer::serve(const std::string& socketPath) {
+		sockaddr_un address{};
+		if (socketPath.size() >= sizeof(address.sun_path)) throw std::string("Socket path too long: ") + socketPath;
+		address.sun_family = AF_UNIX;
+		std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+		// A socket left behind by an earlier server is replaced; any other file is not
+		struct stat info;
+		if (::stat(socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) ::unlink(socketPath.c_str());
+
+		int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener < 0) throw std::string("Unable to create socket: ") + std::strerror(errno);
+		if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listener, 16) < 0) {
+			std::string error = std::strerror(errno);
+			::close(listener);
+			throw std::string("Unable to listen on ") + socketPath + ": " + error;
+		};
+		m_listener = listener;
+		if (m_stopping) ::shutdown(listener, SHUT_RDWR);
+
+		while (!m_stopping) {
+			int client = ::accept(listener, nullptr, nullptr);
+			if (client < 0) {
+				if (errno == EINTR || errno == ECONNABORTED) continue;
+				break;
+			};
+
+			std::lock_guard<std::mutex> lock(m_clientLock);
+			reapConnections();
+			m_clients.push_back(client);
+			m_connections.emplace_back(&SimulationServer::serveClient, this, client);
+		};
+
+		m_listener = -1;
+		::close(listener);
+		::unlink(socketPath.c_str());
+
+		{
+			// Unblocks connections waiting for their next request. Only the read
+			// side, so a reply still being sent (such as to shutdown) arrives.
+			std::lock_guard<std::mutex> lock(m_clientLock);
+			for (int client : m_clients) ::shutdown(client, SHUT_RD);
+		}
+		for (auto& connection : m_connections) connection.join();
+		m_connections.clear();
+		m_finished.clear();
+	};
+
+	void SimulationServer::serveClient(int client) {
+		std::string pending;
+		char buffer[4096];
+		bool open = true;
+
+		while (open) {
+			ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+			if (received < 0 && errno == EINTR) continue;
+			if (received <= 0) break;
+			pending.append(buffer, static_cast<size_t>(received));
+
+			size_t newline;
+			while (open && (newline = pending.find('\n')) != std::string::npos) {
+				std::string reply = handle(pending.substr(0, newline));
+				pending.erase(0, newline + 1);
+
+				size_t sent = 0;
+				while (sent < reply.size()) {
+#ifdef MSG_NOSIGNAL
+					ssize_t written = ::send(client, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+#else
+					ssize_t written = ::send(client, reply.data() + sent, reply.size() - sent, 0);
+#endif
+					if (written < 0 && errno == EINTR) continue;
+					if (written <= 0) {
+						open = false;
+						break;
+					};
+					sent += static_cast<size_t>(written);
+				};
+				if (m_stopping) open = false;
+			};
+		};
+
+		std::lock_guard<std::mutex> lock(m_clientLock);
+		for (size_t i = 0; i < m_clients.size(); i++) {
+			if (m_clients[i] == client) {
+				m_clients.erase(m_clients.begin() + i);
+				break;
+			};
+		};
+		::close(client);
+		m_finished.push_back(std::this_thread::get_id());
+	};
+#else
+	void SimulationServer::serve(const std::string&) {
+		throw std::string("The simulation server needs Unix domain sockets");
+	};
+
+	void SimulationServer::serveClient(int) {};
+#endif
+}
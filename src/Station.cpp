@@ -1,7 +1,10 @@
 #include <string>
 #include <algorithm>
 #include <iostream>
-#include <iomanip>
+#include "BinaryIO.h"
+#include "MemoryTracker.h"
+#include "OutputBuffer.h"
+#include "SharedInventory.h"
 #include "Station.h"
 #include "Utilities.h"
 
@@ -10,54 +13,158 @@ namespace seneca {
 	size_t Station::m_widthField = 0;
 	int Station::id_generator = 0;
 
+	Station::Stock::Stock(const Stock& src) : m_serialNumber(src.m_serialNumber.load(std::memory_order_relaxed)), m_quantity(src.m_quantity.load(std::memory_order_relaxed)) {};
+
+	Station::Stock& Station::Stock::operator=(const Stock& src) {
+		m_serialNumber.store(src.m_serialNumber.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		m_quantity.store(src.m_quantity.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		return *this;
+	};
+
 	Station::Station(const std::string& record) {
+		SENECA_MEMORY_TAG(StationStrings);
 		Utilities util;
 		size_t next_pos = 0;
 		bool more = true;
 
 		m_id = ++id_generator;
 		m_itemName = util.extractToken(record, next_pos, more);
-		m_serialNumber = std::stoi(util.extractToken(record, next_pos, more));
-		m_quantity = std::stoi(util.extractToken(record, next_pos, more));
+		m_stock.m_serialNumber = std::stoi(util.extractToken(record, next_pos, more));
+		m_stock.m_quantity = std::stoi(util.extractToken(record, next_pos, more));
 		m_description = util.extractToken(record, next_pos, more, false);
 		
 		m_widthField = std::max(m_widthField, util.getFieldWidth());
 	};
 
+	// Builds a station from fields that need no parsing, such as a StaticLine's
+	Station::Station(const std::string& itemName, size_t serialNumber, size_t quantity, const std::string& description) {
+		SENECA_MEMORY_TAG(StationStrings);
+		m_id = ++id_generator;
+		m_itemName = itemName;
+		m_description = description;
+		m_stock.m_serialNumber = serialNumber;
+		m_stock.m_quantity = quantity;
+		m_widthField = std::max({ m_widthField, itemName.size(), std::to_string(serialNumber).size(), std::to_string(quantity).size() });
+	};
+
+	int Station::getId() const {
+		return m_id;
+	};
+
+	void Station::setId(int id) {
+		m_id = id;
+	};
+
 	const std::string& Station::getItemName() const {
 		return m_itemName;
 	};
 
+	const std::string& Station::getDescription() const {
+		return m_description;
+	};
+
 	size_t Station::getNextSerialNumber() {
-		return m_serialNumber++;	
+		if (m_inventory) return m_inventory->takeSerialNumbers(m_inventoryItem, 1);
+		return m_stock.m_serialNumber.fetch_add(1, std::memory_order_relaxed);
+	};
+
+	// The serial number the next filled item will receive
+	size_t Station::getSerialNumber() const {
+		if (m_inventory) return m_inventory->getSerialNumber(m_inventoryItem);
+		return m_stock.m_serialNumber.load(std::memory_order_relaxed);
 	};
 
+	// With a shared inventory, what this station's line could still take
 	size_t Station::getQuantity() const {
-		return m_quantity;
+		if (m_inventory) return m_inventory->getAvailable(m_inventoryItem, m_inventoryLine);
+		return m_stock.m_quantity.load(std::memory_order_relaxed);
 	};
 
 	void Station::updateQuantity() {
-		if (m_quantity > 0)
-			m_quantity--;
+		takeStock(1);
+	};
+
+	void Station::setQuantity(size_t quantity) {
+		m_stock.m_quantity.store(quantity, std::memory_order_relaxed);
+	};
+
+	// Takes up to `count` units without going below zero; returns how many
+	size_t Station::takeStock(size_t count) {
+		if (m_inventory) return m_inventory->takeStock(m_inventoryItem, m_inventoryLine, count);
+		size_t available = m_stock.m_quantity.load(std::memory_order_relaxed);
+		size_t granted = 0;
+		do {
+			granted = std::min(count, available);
+			if (granted == 0) return 0;
+		} while (!m_stock.m_quantity.compare_exchange_weak(available, available - granted, std::memory_order_relaxed));
+		return granted;
+	};
+
+	// Stock is claimed first, then the serial range; concurrent callers get
+	// disjoint ranges, though not necessarily in the order their stock was claimed
+	StationReservation Station::reserve(size_t count) {
+		if (m_inventory) return m_inventory->reserve(m_inventoryItem, m_inventoryLine, count);
+		size_t granted = takeStock(count);
+		if (granted == 0) return StationReservation{ getSerialNumber(), 0 };
+		return StationReservation{ m_stock.m_serialNumber.fetch_add(granted, std::memory_order_relaxed), granted };
+	};
+
+	bool Station::drawFrom(SharedInventory* inventory, size_t line) {
+		m_inventory = nullptr;
+		if (!inventory) return false;
+		size_t item = inventory->indexOf(m_itemName);
+		if (item == inventory->getItemCount()) return false;
+		if (line >= inventory->getLineCount()) throw std::string("No line ") + std::to_string(line) + " in the shared inventory";
+
+		m_inventory = inventory;
+		m_inventoryItem = item;
+		m_inventoryLine = line;
+		return true;
 	};
 
 	void Station::display(std::ostream& os, bool full) const {
+		OutputBuffer output(os, 256);
+		display(output, full);
+	};
+
+	void Station::display(OutputBuffer& output, bool full) const {
+		display(output, full, m_widthField);
+	};
+
+	void Station::display(OutputBuffer& output, bool full, size_t width) const {
 		// ID: 3 characters, right justified, zero-padded
-		os << std::right << std::setw(3) << std::setfill('0') << m_id << " | ";
+		output.writeRight(static_cast<size_t>(m_id), 3, '0') << " | ";
 		// Name: left justified using the maximum field width
-		os << std::left << std::setw(m_widthField) << std::setfill(' ') << m_itemName << " | ";
+		output.writeLeft(m_itemName, width) << " | ";
 		// Serial: 6 characters, right justified, zero-padded
-		os << std::right << std::setw(6) << std::setfill('0') << m_serialNumber << " | ";
+		output.writeRight(getSerialNumber(), 6, '0') << " | ";
 
 		if (full) {
 		    // Quantity: 4 characters, right justified
-		    os << std::right << std::setw(4) << std::setfill(' ') << m_quantity << " | ";
+		    output.writeRight(getQuantity(), 4) << " | ";
 		    // Description: no specific formatting
-		    os << m_description;
+		    output << m_description;
 		}
-		os << std::endl;
+		output << '\n';
 	};
 	
+	// Writes the stock that changes during a run plus the displayed id; the
+	// name guards against restoring into a different station
+	void Station::saveState(std::ostream& os) const {
+		writeBinary(os, m_itemName);
+		writeBinary(os, m_id);
+		writeBinary(os, getSerialNumber());
+		writeBinary(os, getQuantity());
+	};
+
+	void Station::loadState(std::istream& is) {
+		std::string itemName = readBinaryString(is);
+		if (itemName != m_itemName) throw std::string("Checkpoint station ") + itemName + " does not match " + m_itemName;
+		m_id = static_cast<int>(readBinary(is));
+		m_stock.m_serialNumber.store(readBinary(is), std::memory_order_relaxed);
+		setQuantity(readBinary(is));
+	};
+
 	// Static method to reset the width field for testing
         void Station::resetWidthField() {
             Station::m_widthField = 0;
@@ -67,4 +174,8 @@ namespace seneca {
         size_t Station::getStaticWidthField() {
             return Station::m_widthField;
         }
+
+        void Station::setStaticWidthField(size_t width) {
+            Station::m_widthField = width;
+        }
 }
@@ -0,0 +1,47 @@
+#include <utility>
+#include "Parallel.h"
+#include "ThreadPool.h"
+
+namespace seneca {
+	ThreadPool::ThreadPool(size_t workers) {
+		workers = resolveWorkerCount(workers);
+		for (size_t i = 0; i < workers; i++) {
+			m_workers.emplace_back(&ThreadPool::work, this);
+		};
+	};
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_stopping = true;
+		}
+		m_ready.notify_all();
+		for (auto& worker : m_workers) worker.join();
+	};
+
+	void ThreadPool::submit(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_tasks.push_back(std::move(task));
+		}
+		m_ready.notify_one();
+	};
+
+	size_t ThreadPool::getWorkerCount() const {
+		return m_workers.size();
+	};
+
+	void ThreadPool::work() {
+		for (;;) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_lock);
+				m_ready.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+				if (m_tasks.empty()) return;
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			task();
+		};
+	};
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include "CustomerOrder.h"
+#include "TraceExporter.h"
+#include "Workstation.h"
+
+namespace seneca {
+	namespace {
+		// Trace timestamps are in microseconds
+		const size_t c_iterationLength = 1000;
+	}
+
+	TraceExporter::TraceExporter(std::ostream& os, const LineManager& manager) : m_output(os) {
+		m_output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		m_output << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"Assembly line\"}}";
+
+		// Tracks appear in line order, one per station
+		const auto& line = manager.getActiveLine();
+		for (size_t i = 0; i < line.size(); i++) {
+			m_stationIndex[line[i]] = i;
+			m_departed.push_back(0);
+			beginEvent();
+			m_output << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << i + 1 << ",\"args\":{\"name\":";
+			writeString(line[i]->getItemName());
+			m_output << "}}";
+			beginEvent();
+			m_output << "{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":1,\"tid\":" << i + 1
+				<< ",\"args\":{\"sort_index\":" << i << "}}";
+		};
+		m_firstIteration = manager.getIterationCount() + 1;
+	};
+
+	TraceExporter::~TraceExporter() {
+		try {
+			finish();
+		} catch (...) {
+		};
+	};
+
+	void TraceExporter::finish() {
+		if (m_finished) return;
+		m_output << "\n]}\n";
+		m_output.flush();
+		m_finished = true;
+	};
+
+	size_t TraceExporter::indexOf(const Station& station) const {
+		auto it = m_stationIndex.find(&station);
+		if (it == m_stationIndex.end()) throw std::string("Trace event from a station outside the line: ") + station.getItemName();
+		return it->second;
+	};
+
+	void TraceExporter::beginEvent() {
+		m_output << ",\n";
+	};
+
+	void TraceExporter::writeString(const std::string& text) {
+		static const char hex[] = "0123456789abcdef";
+		m_output << '"';
+		for (char ch : text) {
+			if (ch == '"' || ch == '\\') {
+				m_output << '\\' << ch;
+			} else if (static_cast<unsigned char>(ch) < 0x20) {
+				m_output << "\\u00" << hex[(ch >> 4) & 0xF] << hex[ch & 0xF];
+			} else {
+				m_output << ch;
+			};
+		};
+		m_output << '"';
+	};
+
+	// The order leaves the station at the end of the current iteration. Its
+	// slice starts when it reached the front of the queue, so slices on one
+	// track follow each other instead of overlapping. Any time before that,
+	// spent queueing behind other orders, is an async span of its own: those
+	// may overlap, one row per waiting order.
+	void TraceExporter::writeSlice(const Station& from, const CustomerOrder& order, bool last) {
+		size_t station = indexOf(from);
+		size_t id = order.getId();
+		size_t end = m_iteration * c_iterationLength;
+		size_t arrival = (m_firstIteration - 1) * c_iterationLength;	// already in the line when tracing began
+		auto arrived = m_arrived.find(id);
+		if (arrived != m_arrived.end()) arrival = arrived->second;
+		size_t start = std::max(arrival, m_departed[station]);
+		m_departed[station] = end;
+
+		if (start > arrival) {
+			beginEvent();
+			m_output << "{\"ph\":\"b\",\"cat\":\"queue\",\"name\":";
+			writeString(from.getItemName() + " queue");
+			m_output << ",\"id\":" << id << ",\"pid\":1,\"tid\":" << station + 1 << ",\"ts\":" << arrival
+				<< ",\"args\":{\"order\":" << id << "}}";
+			beginEvent();
+			m_output << "{\"ph\":\"e\",\"cat\":\"queue\",\"name\":";
+			writeString(from.getItemName() + " queue");
+			m_output << ",\"id\":" << id << ",\"pid\":1,\"tid\":" << station + 1 << ",\"ts\":" << start << "}";
+		};
+
+		beginEvent();
+		m_output << "{\"ph\":\"X\",\"cat\":\"order\",\"name\":";
+		writeString(order.getName() + ", " + order.getProduct());
+		m_output << ",\"pid\":1,\"tid\":" << station + 1 << ",\"ts\":" << start << ",\"dur\":" << end - start
+			<< ",\"args\":{\"order\":" << id << "}}";
+
+		// One arrow per order, from its first slice through to its last
+		bool flowing = m_flowing[id];
+		if (!(last && !flowing)) {
+			const char* phase = !flowing ? "s" : (last ? "f" : "t");
+			beginEvent();
+			m_output << "{\"ph\":\"" << phase << "\",\"cat\":\"order\",\"name\":\"order\",\"id\":" << id
+				<< ",\"pid\":1,\"tid\":" << station + 1 << ",\"ts\":" << start << ",\"bp\":\"e\"}";
+		};
+
+		if (last) {
+			m_arrived.erase(id);
+			m_flowing.erase(id);
+		} else {
+			m_arrived[id] = end;
+			m_flowing[id] = true;
+		};
+	};
+
+	void TraceExporter::onIteration(size_t iteration) {
+		m_iteration = iteration;
+	};
+
+	void TraceExporter::onAdmit(const Workstation&, const CustomerOrder& order) {
+		m_arrived[order.getId()] = (m_iteration - 1) * c_iterationLength;
+	};
+
+	void TraceExporter::onFill(const Station& station, const CustomerOrder& order, size_t item, bool filled) {
+		beginEvent();
+		m_output << "{\"ph\":\"i\",\"s\":\"t\",\"cat\":\"fill\",\"name\":" << (filled ? "\"Filled\"" : "\"Unable to fill\"")
+			<< ",\"pid\":1,\"tid\":" << indexOf(station) + 1 << ",\"ts\":" << (m_iteration - 1) * c_iterationLength
+			<< ",\"args\":{\"order\":" << order.getId() << ",\"item\":";
+		writeString(order.getItemName(item));
+		m_output << "}}";
+	};
+
+	void TraceExporter::onMove(const Workstation& from, const Workstation&, const CustomerOrder& order) {
+		writeSlice(from, order, false);
+	};
+
+	void TraceExporter::onFinish(const Workstation& station, const CustomerOrder& order, bool) {
+		writeSlice(station, order, true);
+	};
+}
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "MemoryTracker.h"
+
+// Replaces the global allocation functions so MemoryTracker sees every heap
+// allocation. Link this into an executable (MEMORY_TRACKING, the tests and
+// the bench) rather than into the shared sources: a program may replace them
+// only once.
+namespace {
+	// Keeps the size and the tracker cell in front of each block; 16 bytes
+	// preserves the alignment malloc guarantees
+	struct alignas(16) BlockHeader {
+		uint64_t m_size;
+		uint32_t m_cell;
+	};
+
+	void* trackedAllocate(std::size_t size) {
+		void* memory = std::malloc(sizeof(BlockHeader) + size);
+		if (!memory) throw std::bad_alloc();
+		BlockHeader* header = static_cast<BlockHeader*>(memory);
+		header->m_size = size;
+		header->m_cell = seneca::trackAllocation(size);
+		return header + 1;
+	}
+
+	void trackedFree(void* memory) noexcept {
+		if (!memory) return;
+		BlockHeader* header = static_cast<BlockHeader*>(memory) - 1;
+		seneca::trackDeallocation(header->m_cell, header->m_size);
+		std::free(header);
+	}
+}
+
+void* operator new(std::size_t size) {
+	return trackedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return trackedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return trackedAllocate(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return trackedAllocate(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void operator delete(void* memory) noexcept {
+	trackedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	trackedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	trackedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+	trackedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+	trackedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+	trackedFree(memory);
+}
@@ -1,20 +1,26 @@
 #include <iostream>
+#include "BinaryIO.h"
+#include "MemoryTracker.h"
+#include "OutputBuffer.h"
 #include "Workstation.h"
 
 namespace seneca {
-	std::deque<CustomerOrder> g_pending;
-	std::deque<CustomerOrder> g_completed;
-	std::deque<CustomerOrder> g_incomplete;
+	thread_local std::deque<CustomerOrder> g_pending;
+	thread_local std::deque<CustomerOrder> g_completed;
+	thread_local std::deque<CustomerOrder> g_incomplete;
 
 	Workstation::Workstation(const std::string& record) : Station(record), m_pNextStaion(nullptr) {};
 
+	Workstation::Workstation(const Station& prototype) : Station(prototype), m_pNextStaion(nullptr) {};
+
 	void Workstation::fill(std::ostream& os) {
 		if (!m_orders.empty()) {
-			m_orders.front().fillItem(*this, os);
+			m_orders.front().fillItem(*this, os, m_observer);
 		};
 	};
 
 	bool Workstation::attemptToMoveOrder() {
+		SENECA_MEMORY_TAG(DequeChunks);
 		bool isMoved = false;
 
 		if(!m_orders.empty()) {
@@ -22,11 +28,16 @@ namespace seneca {
 
 			if(isDone) {
 				if (m_pNextStaion) {
+					if (m_observer) m_observer->onMove(*this, *m_pNextStaion, m_orders.front());
 					*m_pNextStaion += std::move(m_orders.front());
 					m_orders.pop_front();
 					isMoved = true;		
 				} else {
-					if (m_orders.front().isOrderFilled()) {
+					if (m_observer) m_observer->onFinish(*this, m_orders.front(), m_orders.front().isOrderFilled());
+					if (m_sink) {
+						bool completed = m_orders.front().isOrderFilled();
+						m_sink->accept(std::move(m_orders.front()), completed);
+					} else if (m_orders.front().isOrderFilled()) {
 					g_completed.push_back(std::move(m_orders.front()));
 					} else {
 						g_incomplete.push_back(std::move(m_orders.front()));
@@ -49,16 +60,55 @@ namespace seneca {
 		return m_pNextStaion;
 	};
 
+	size_t Workstation::getQueueLength() const {
+		return m_orders.size();
+	};
+
+	void Workstation::setObserver(SimulationObserver* observer) {
+		m_observer = observer;
+	};
+
+	// Finished orders go to the sink instead of g_completed/g_incomplete; nullptr restores them
+	void Workstation::setResultSink(ResultSink* sink) {
+		m_sink = sink;
+	};
+
 	void Workstation::display(std::ostream& os) const {
+		OutputBuffer output(os, 256);
+		display(output);
+	};
+
+	void Workstation::display(OutputBuffer& output) const {
 		if (m_pNextStaion) {
-			os << this->getItemName() << m_pNextStaion->getItemName() << std::endl;
+			output << this->getItemName() << m_pNextStaion->getItemName() << '\n';
 		} else {
-			os << this->getItemName() << "End of Line"<< std::endl;
+			output << this->getItemName() << "End of Line" << '\n';
 		}
 	};
 
 	Workstation& Workstation::operator+=(CustomerOrder&& newOrder) {
+		SENECA_MEMORY_TAG(DequeChunks);
 		m_orders.push_back(std::move(newOrder));
 		return *this;
 	};
+
+	// Stock plus every order waiting at this station, front of the queue first
+	void Workstation::saveState(std::ostream& os) const {
+		Station::saveState(os);
+		writeBinary(os, m_orders.size());
+		for (const auto& order : m_orders) {
+			order.saveState(os);
+		};
+	};
+
+	void Workstation::loadState(std::istream& is) {
+		Station::loadState(is);
+		m_orders.clear();
+		SENECA_MEMORY_TAG(DequeChunks);
+		for (size_t i = readBinary(is); i > 0; i--) {
+			CustomerOrder order;
+			order.loadState(is);
+			m_orders.push_back(std::move(order));
+		};
+	};
 }
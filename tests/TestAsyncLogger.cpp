@@ -0,0 +1,140 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "AsyncLogger.h"
+#include "OutputBuffer.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    std::vector<Workstation*> loadAsyncLoggerTestLine() {
+        return loadTestStations({
+            "Desk,100,2,Worktable",
+            "Chair,200,3,Office chair",
+            "Lamp,300,1,Desk lamp"
+        }, {
+            "Alice|Office|Desk|Chair|Lamp",
+            "Bob|Study|Desk|Lamp|Chair|Chair",
+            "Carol|Den|Desk|Desk|Lamp"
+        });
+    }
+
+    // The log LineManager::run writes directly, and the one AsyncLogger writes
+    // for the same run through a ring of `capacity` bytes
+    void runBothLogs(size_t capacity, std::string& direct, std::string& async) {
+        char originalDelimiter = Utilities::getDelimiter();
+        
+        clearGlobalQueues();
+        std::vector<Workstation*> stations = loadAsyncLoggerTestLine();
+        std::ostringstream directLog;
+        {
+            LineManager manager(stations);
+            while (!manager.run(directLog));
+        }
+        for (auto* station : stations) delete station;
+        direct = directLog.str();
+        
+        clearGlobalQueues();
+        stations = loadAsyncLoggerTestLine();
+        std::ostringstream asyncLog;
+        {
+            AsyncLogger logger(asyncLog, capacity);
+            LineManager manager(stations);
+            manager.setObserver(&logger);
+            std::ostream discard(nullptr);
+            while (!manager.run(discard));
+            logger.close();
+        }
+        for (auto* station : stations) delete station;
+        async = asyncLog.str();
+        
+        clearGlobalQueues();
+        Utilities::setDelimiter(originalDelimiter);
+    }
+}
+
+TEST_CASE("AsyncLogger - Matches Direct Log Byte For Byte") {
+    std::string direct, async;
+    runBothLogs(1 << 20, direct, async);
+    
+    CHECK(direct.find("Unable to fill") != std::string::npos);
+    CHECK_EQ(async, direct);
+}
+
+TEST_CASE("AsyncLogger - Small Ring Wraps And Waits For The Writer") {
+    std::string direct, async;
+    runBothLogs(64, direct, async);
+    
+    CHECK_EQ(async, direct);
+}
+
+TEST_CASE("AsyncLogger - Close Is Idempotent") {
+    std::ostringstream log;
+    AsyncLogger logger(log);
+    logger.onIteration(7);
+    logger.close();
+    logger.close();
+    
+    CHECK_EQ(log.str(), "Line Manager Iteration: 7\n");
+}
+
+TEST_CASE("OutputBuffer - Writes In Blocks") {
+    std::ostringstream os;
+    {
+        OutputBuffer buffer(os, 16);
+        buffer << "Iteration " << size_t(0) << ' ' << size_t(18446744073709551615ull);
+        CHECK_EQ(buffer.getPending(), 0u);	// overflowed the block and was written
+        buffer << std::string("abc");
+        CHECK_EQ(buffer.getPending(), 3u);
+        buffer.flush();
+        CHECK_EQ(buffer.getPending(), 0u);
+        buffer << "tail";
+    }
+    CHECK_EQ(os.str(), "Iteration 0 18446744073709551615abctail");
+}
+
+TEST_CASE("OutputBuffer - Pads Like iomanip") {
+    const std::vector<size_t> values = { 0, 7, 42, 999, 123456, 1234567, 18446744073709551615ull };
+    const std::vector<std::string> texts = { "", "Desk", "Office Chair", "A much longer item name" };
+    std::ostringstream expected;
+    std::ostringstream actual;
+    {
+        // A small block, so padding also crosses a flush
+        OutputBuffer buffer(actual, 8);
+        for (size_t width : { 0, 1, 3, 6, 12 }) {
+            for (size_t value : values) {
+                expected << std::right << std::setw(width) << std::setfill('0') << value << '|'
+                         << std::setw(width) << std::setfill(' ') << value << '|';
+                buffer.writeRight(value, width, '0') << '|';
+                buffer.writeRight(value, width) << '|';
+            }
+            for (const auto& text : texts) {
+                expected << std::left << std::setw(width) << std::setfill(' ') << text << '|';
+                buffer.writeLeft(text, width) << '|';
+            }
+        }
+        for (size_t width : { 0, 4, 11 }) {
+            for (const auto& text : texts) {
+                expected << std::right << std::setw(width) << text << '|';
+                buffer.writeRight(text, width) << '|';
+            }
+            for (double value : { 0.0, 0.125, 2.5, -3.75, 1234.5678, 1e30, 1e100 }) {
+                for (int decimals : { 0, 1, 2, 3 }) {
+                    expected << std::fixed << std::setprecision(decimals) << std::setw(width) << value << '|';
+                    buffer.writeFixed(value, decimals, width) << '|';
+                }
+            }
+        }
+        buffer.pad(20, '-');
+        expected << std::string(20, '-');
+    }
+    CHECK_EQ(actual.str(), expected.str());
+}
@@ -0,0 +1,178 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "BatchRunner.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    // Inputs for the manifests below, in a directory of their own
+    std::filesystem::path makeBatchTestInputs() {
+        std::filesystem::path directory = "temp_batch";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        writeTestFile(directory / "stations1.txt", "Desk,100,2,Office desk\n");
+        writeTestFile(directory / "stations2.txt", "Chair;200;5;Office chair\n");
+        writeTestFile(directory / "orders.txt",
+            "Alice|Office|Desk|Chair\n"
+            "Bob|Office|Desk|Chair\n"
+            "Carol|Office|Desk\n");
+        writeTestFile(directory / "line.txt", "Desk|Chair\nChair\n");
+        return directory;
+    }
+}
+
+TEST_CASE("BatchRunner - Manifest") {
+    std::filesystem::path directory = makeBatchTestInputs();
+    writeTestFile(directory / "manifest.txt",
+        "# two desks\n"
+        "[base]\n"
+        "stations = stations1.txt\n"
+        "stations = stations2.txt ;\n"
+        "orders = orders.txt\n"
+        "line = line.txt\n"
+        "\n"
+        "[more-desks]\n"
+        "stations = stations1.txt ,\n"
+        "stations = stations2.txt ;\n"
+        "orders = orders.txt |\n"
+        "line = line.txt\n"
+        "engine = fill-all,priority,quiet\n"
+        "stock = Desk=3\n"
+        "report = jsonl\n");
+
+    BatchRunner runner;
+    runner.loadManifest((directory / "manifest.txt").string());
+    const std::vector<BatchJob>& jobs = runner.getJobs();
+    REQUIRE_EQ(jobs.size(), 2u);
+    CHECK_EQ(jobs[0].m_name, "base");
+    REQUIRE_EQ(jobs[0].m_stations.size(), 2u);
+    CHECK_EQ(jobs[0].m_stations[0].m_file, (directory / "stations1.txt").string());
+    CHECK_EQ(jobs[0].m_stations[0].m_delimiter, ',');
+    CHECK_EQ(jobs[0].m_stations[1].m_delimiter, ';');
+    CHECK_EQ(jobs[0].m_orders.m_delimiter, '|');
+    CHECK_EQ(jobs[0].m_engine, "fast-forward");
+    CHECK_EQ(jobs[1].m_engine, "fill-all,priority,quiet");
+    CHECK_EQ(jobs[1].m_stock.at("Desk"), 3u);
+    CHECK(jobs[0].m_report.empty());
+    CHECK_EQ(jobs[1].m_report, "jsonl");
+
+    const std::vector<std::string> invalid = {
+        "stations = a.txt\n",
+        "[x]\nstations = a.txt\nline = b.txt\n",
+        "[x]\ncolour = blue\n",
+        "[x]\nstations = a.txt\norders = b.txt\nline = c.txt\nengine = lifo\n",
+        "[x]\nstations = a.txt\norders = b.txt\nline = c.txt\nreport = xml\n",
+        "[x]\nstations = a.txt\norders = b.txt\nline = c.txt\n[x]\nstations = a.txt\norders = b.txt\nline = c.txt\n"
+    };
+    for (const auto& manifest : invalid) {
+        CAPTURE(manifest);
+        writeTestFile(directory / "invalid.txt", manifest);
+        BatchRunner rejecting;
+        CHECK_THROWS_AS(rejecting.loadManifest((directory / "invalid.txt").string()), std::string);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BatchRunner - Runs Scenarios And Shares Inputs") {
+    std::filesystem::path directory = makeBatchTestInputs();
+    std::string stations1 = (directory / "stations1.txt").string();
+    std::string stations2 = (directory / "stations2.txt").string();
+    std::string orders = (directory / "orders.txt").string();
+    std::string line = (directory / "line.txt").string();
+
+    BatchRunner runner(4);
+    for (int i = 0; i < 20; i++) {
+        BatchJob job;
+        job.m_name = "stock-" + std::to_string(i);
+        job.m_stations = { { stations1, ',' }, { stations2, ';' } };
+        job.m_orders = { orders, '|' };
+        job.m_line = line;
+        job.m_engine = i % 2 ? "tick" : "fast-forward";
+        job.m_stock["Desk"] = i % 4;
+        if (i == 0) job.m_report = "csv";
+        runner.addJob(job);
+    }
+    BatchJob broken;
+    broken.m_name = "broken";
+    broken.m_stations = { { stations1, ',' } };
+    broken.m_orders = { (directory / "missing.txt").string(), '|' };
+    broken.m_line = line;
+    runner.addJob(broken);
+
+    std::filesystem::path output = directory / "results";
+    std::vector<BatchOutcome> outcomes = runner.run(output.string());
+    REQUIRE_EQ(outcomes.size(), 21u);
+    for (int i = 0; i < 20; i++) {
+        CAPTURE(i);
+        CHECK(outcomes[i].m_error.empty());
+        CHECK_EQ(outcomes[i].m_result.m_completed, std::min(i % 4, 3));
+        CHECK(std::filesystem::exists(output / ("stock-" + std::to_string(i) + ".txt")));
+    }
+    CHECK(outcomes[20].m_error.find("missing.txt") != std::string::npos);
+    CHECK_FALSE(std::filesystem::exists(output / "broken.txt"));
+
+    // Two station files, the orders and the line, read once for all twenty
+    CHECK_EQ(runner.getFilesParsed(), 4u);
+    CHECK_EQ(runner.getScenariosBuilt(), 1u);
+
+    std::string result = readTestFile(output / "stock-1.txt");
+    CHECK(result.rfind("Line Manager Iteration: 1\n", 0) == 0);
+    CHECK(result.find("\nCompleted Orders:\nAlice - Office\n") != std::string::npos);
+    CHECK(result.find("\nRemaining Inventory:\n") != std::string::npos);
+    CHECK(readTestFile(output / "stock-2.txt").rfind("\nCompleted Orders:\n", 0) == 0);
+    CHECK(readTestFile(output / "stock-0.csv").find("\nstation,") != std::string::npos);
+    CHECK_FALSE(std::filesystem::exists(output / "stock-1.csv"));
+
+    std::string summary = readTestFile(output / "summary.txt");
+    CHECK(summary.rfind("Scenario | Completed | Incomplete | Iterations | Status\n", 0) == 0);
+    CHECK(summary.find("\nstock-3  |         3 |          0 |") != std::string::npos);
+    CHECK(summary.find("| error: Unable to open") != std::string::npos);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BatchRunner - Scenario Output Does Not Depend On The Manifest") {
+    std::filesystem::path directory = makeBatchTestInputs();
+    // Parsed first, with more stations and longer names than the others
+    writeTestFile(directory / "warehouse.txt",
+        "Ergonomic Standing Desk,500,4,Motorised sit-stand desk\n"
+        "Filing Cabinet,600,2,Four drawers\n");
+    writeTestFile(directory / "warehouse_orders.txt", "Dana|Executive Office Suite|Ergonomic Standing Desk|Filing Cabinet\n");
+    writeTestFile(directory / "warehouse_line.txt", "Ergonomic Standing Desk|Filing Cabinet\nFiling Cabinet\n");
+
+    std::string office =
+        "[office]\n"
+        "stations = stations1.txt\n"
+        "stations = stations2.txt ;\n"
+        "orders = orders.txt\n"
+        "line = line.txt\n"
+        "report = csv\n";
+    writeTestFile(directory / "alone.txt", office);
+    writeTestFile(directory / "together.txt",
+        "[warehouse]\n"
+        "stations = warehouse.txt\n"
+        "orders = warehouse_orders.txt\n"
+        "line = warehouse_line.txt\n"
+        "\n" + office);
+
+    BatchRunner alone;
+    alone.loadManifest((directory / "alone.txt").string());
+    alone.run((directory / "alone").string());
+    BatchRunner together;
+    together.loadManifest((directory / "together.txt").string());
+    together.run((directory / "together").string());
+
+    for (const char* file : { "office.txt", "office.csv" }) {
+        CAPTURE(file);
+        std::string result = readTestFile(directory / "alone" / file);
+        CHECK_FALSE(result.empty());
+        CHECK_EQ(readTestFile(directory / "together" / file), result);
+    }
+    CHECK(readTestFile(directory / "alone" / "office.txt").find("\n001 | Desk  | 000102 |") != std::string::npos);
+    std::filesystem::remove_all(directory);
+}
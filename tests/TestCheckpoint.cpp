@@ -0,0 +1,130 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "Checkpoint.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Station.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    // Fresh stations and pending orders, as a new process would load them
+    std::vector<Workstation*> loadCheckpointTestStations(bool withOrders) {
+        std::vector<Workstation*> stations = loadTestStations({
+            "Desk,100000,3,Office desk",
+            "Chair,200000,2,Office chair",
+            "Lamp,300000,4,Desk lamp"
+        });
+
+        if (withOrders) {
+            Utilities::setDelimiter('|');
+            g_pending.push_back(CustomerOrder("Alice|Office|Desk|Chair|Lamp|Lamp"));
+            g_pending.push_back(CustomerOrder("Bob|Office|Desk|Desk|Chair"));
+            g_pending.push_back(CustomerOrder("Charlie|Reading Corner|Lamp|Chair"));
+            g_pending.push_back(CustomerOrder("Dana|Office|Desk|Lamp"));
+        }
+        return stations;
+    }
+
+    std::string describeResults(const std::vector<Workstation*>& stations) {
+        std::ostringstream oss;
+        for (const auto& order : g_completed) order.display(oss);
+        oss << "--\n";
+        for (const auto& order : g_incomplete) order.display(oss);
+        oss << "--\n";
+        // Station ids depend on how many stations this test binary has created,
+        // so compare everything after the id column
+        for (const auto* station : stations) {
+            std::ostringstream line;
+            station->Station::display(line, true);
+            oss << line.str().substr(line.str().find('|'));
+        }
+        return oss.str();
+    }
+}
+
+TEST_CASE("Checkpoint - Restored Run Continues Identically") {
+    char originalDelimiter = Utilities::getDelimiter();
+    
+    // Reference: one uninterrupted run
+    clearGlobalQueues();
+    std::vector<Workstation*> reference = loadCheckpointTestStations(true);
+    LineManager referenceManager(reference);
+    std::ostringstream referenceLog;
+    std::vector<size_t> iterationEnds;
+    while (!referenceManager.run(referenceLog)) {
+        iterationEnds.push_back(referenceLog.str().size());
+    }
+    std::string referenceResults = describeResults(reference);
+    size_t referenceIterations = referenceManager.getIterationCount();
+    REQUIRE(iterationEnds.size() > 4);
+    
+    // Interrupted run: stop after four iterations and checkpoint
+    clearGlobalQueues();
+    std::vector<Workstation*> first = loadCheckpointTestStations(true);
+    LineManager firstManager(first);
+    std::ostringstream firstLog;
+    for (int i = 0; i < 4; i++) firstManager.run(firstLog);
+    std::stringstream checkpoint;
+    saveCheckpoint(checkpoint, firstManager, first);
+    deleteTestStations(first);
+    
+    // Restore into brand new objects with empty queues and continue
+    clearGlobalQueues();
+    size_t orderWidth = CustomerOrder::getWidthField();
+    CustomerOrder::setWidthField(0);
+    std::vector<Workstation*> second = loadCheckpointTestStations(false);
+    LineManager secondManager(second);
+    restoreCheckpoint(checkpoint, secondManager, second);
+    CHECK_EQ(CustomerOrder::getWidthField(), orderWidth);
+    CHECK_EQ(secondManager.getIterationCount(), 4u);
+    
+    std::ostringstream secondLog;
+    while (!secondManager.run(secondLog));
+    
+    CHECK_EQ(firstLog.str() + secondLog.str(), referenceLog.str());
+    CHECK_EQ(describeResults(second), referenceResults);
+    CHECK_EQ(secondManager.getIterationCount(), referenceIterations);
+    
+    deleteTestStations(reference);
+    deleteTestStations(second);
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("Checkpoint - Rejects Mismatched Input") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    std::vector<Workstation*> stations = loadCheckpointTestStations(true);
+    LineManager manager(stations);
+    std::ostringstream log;
+    manager.run(log);
+    std::stringstream checkpoint;
+    saveCheckpoint(checkpoint, manager, stations);
+    
+    // Stations loaded in a different order cannot take this checkpoint
+    Utilities::setDelimiter(',');
+    std::vector<Workstation*> swapped = {
+        new Workstation("Chair,200000,2,Office chair"),
+        new Workstation("Desk,100000,3,Office desk"),
+        new Workstation("Lamp,300000,4,Desk lamp")
+    };
+    LineManager swappedManager(swapped);
+    CHECK_THROWS_AS(restoreCheckpoint(checkpoint, swappedManager, swapped), std::string);
+    
+    // Neither can something that is not a checkpoint at all
+    std::stringstream garbage("not a checkpoint");
+    CHECK_THROWS_AS(restoreCheckpoint(garbage, manager, stations), std::string);
+    
+    deleteTestStations(stations);
+    deleteTestStations(swapped);
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
@@ -0,0 +1,197 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "EventLog.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    std::vector<Workstation*> loadEventLogTestScenario(size_t lampStock) {
+        return loadTestStations({
+            "Desk,100000,3,Office desk",
+            "Chair,200000,2,Office chair",
+            "Lamp,300000," + std::to_string(lampStock) + ",Desk lamp"
+        }, {
+            "Alice|Office|Desk|Chair|Lamp|Lamp",
+            "Bob|Office|Desk|Desk|Chair",
+            "Charlie|Reading Corner|Lamp|Chair",
+            "Dana|Office|Desk|Lamp"
+        });
+    }
+
+    // Runs to completion (or `iterations`) while recording; returns the console log
+    std::string recordEventLogTestRun(std::vector<Workstation*>& stations, std::ostream& log, size_t iterations = 0) {
+        LineManager manager(stations);
+        EventRecorder recorder(log, manager);
+        manager.setObserver(&recorder);
+
+        std::ostringstream console;
+        bool finished = false;
+        while (!finished && (iterations == 0 || manager.getIterationCount() < iterations)) {
+            finished = manager.run(console);
+        }
+        return console.str();
+    }
+
+    size_t countOccurrences(const std::string& text, const std::string& word) {
+        size_t count = 0;
+        for (size_t pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + 1)) count++;
+        return count;
+    }
+}
+
+TEST_CASE("EventLog - Replay Rebuilds Final State") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    std::vector<Workstation*> stations = loadEventLogTestScenario(2);
+    std::stringstream log;
+    std::string console = recordEventLogTestRun(stations, log);
+    
+    ReplayState state = ReplayState::replay(log);
+    
+    REQUIRE_EQ(state.getCompleted().size(), g_completed.size());
+    REQUIRE_EQ(state.getIncomplete().size(), g_incomplete.size());
+    CHECK(state.getPending().empty());
+    
+    for (size_t i = 0; i < g_completed.size(); i++) {
+        const LoggedOrder& replayed = state.getOrder(state.getCompleted()[i]);
+        const CustomerOrder& actual = g_completed[i];
+        CHECK_EQ(replayed.m_name, actual.getName());
+        REQUIRE_EQ(replayed.m_items.size(), actual.getItemCount());
+        for (size_t j = 0; j < actual.getItemCount(); j++) {
+            CHECK_EQ(replayed.m_items[j].m_isFilled, actual.isItemFilledAt(j));
+            CHECK_EQ(replayed.m_items[j].m_serialNumber, actual.getItemSerialNumber(j));
+        }
+    }
+    for (size_t i = 0; i < g_incomplete.size(); i++) {
+        CHECK_EQ(state.getOrder(state.getIncomplete()[i]).m_name, g_incomplete[i].getName());
+    }
+    for (size_t i = 0; i < stations.size(); i++) {
+        CHECK_EQ(state.getStations()[i].m_name, stations[i]->getItemName());
+        CHECK_EQ(state.getStations()[i].m_quantity, stations[i]->getQuantity());
+        CHECK_EQ(state.getStations()[i].m_serialNumber, stations[i]->getSerialNumber());
+    }
+    
+    // Every console message has a matching event
+    std::stringstream again(log.str());
+    EventLogReader reader(again);
+    LoggedEvent event;
+    size_t fills = 0;
+    size_t unable = 0;
+    while (reader.next(event)) {
+        if (event.m_type == EventType::Fill) fills++;
+        if (event.m_type == EventType::UnableToFill) unable++;
+    }
+    CHECK_EQ(fills, countOccurrences(console, "    Filled "));
+    CHECK_EQ(unable, countOccurrences(console, "Unable to fill "));
+    
+    deleteTestStations(stations);
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("EventLog - Replayed Listing Matches The Run") {
+    char originalDelimiter = Utilities::getDelimiter();
+    size_t originalWidth = CustomerOrder::getWidthField();
+    clearGlobalQueues();
+    
+    // "Reading Corner", a product, is the longest token of these orders
+    CustomerOrder::setWidthField(1);
+    std::vector<Workstation*> stations = loadEventLogTestScenario(2);
+    REQUIRE_EQ(CustomerOrder::getWidthField(), std::string("Reading Corner").size());
+    std::stringstream log;
+    recordEventLogTestRun(stations, log);
+    
+    std::ostringstream live;
+    live << "Completed Orders:\n";
+    for (const auto& order : g_completed) order.display(live);
+    live << "\nIncomplete Orders:\n";
+    for (const auto& order : g_incomplete) order.display(live);
+    
+    // A later load may widen the live column; the log keeps the run's width
+    CustomerOrder::setWidthField(40);
+    std::ostringstream replayed;
+    ReplayState::replay(log).display(replayed);
+    size_t begin = replayed.str().find("Completed Orders:\n");
+    size_t end = replayed.str().find("\nRemaining Inventory:\n");
+    REQUIRE(begin != std::string::npos);
+    REQUIRE(end != std::string::npos);
+    CHECK_EQ(replayed.str().substr(begin, end - begin), live.str());
+    
+    deleteTestStations(stations);
+    clearGlobalQueues();
+    CustomerOrder::setWidthField(originalWidth);
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("EventLog - Replay To An Iteration") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    std::vector<Workstation*> full = loadEventLogTestScenario(2);
+    std::stringstream log;
+    recordEventLogTestRun(full, log);
+    deleteTestStations(full);
+    clearGlobalQueues();
+    
+    // A second run stopped after five iterations is the ground truth
+    std::vector<Workstation*> partial = loadEventLogTestScenario(2);
+    std::stringstream unused;
+    recordEventLogTestRun(partial, unused, 5);
+    
+    ReplayState state = ReplayState::replay(log, 5);
+    CHECK_EQ(state.getIteration(), 5u);
+    CHECK_EQ(state.getPending().size(), g_pending.size());
+    CHECK_EQ(state.getCompleted().size(), g_completed.size());
+    CHECK_EQ(state.getIncomplete().size(), g_incomplete.size());
+    for (size_t i = 0; i < partial.size(); i++) {
+        CHECK_EQ(state.getStations()[i].m_quantity, partial[i]->getQuantity());
+    }
+    
+    deleteTestStations(partial);
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("EventLog - Runs With Different Stock Diverge") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    std::vector<Workstation*> first = loadEventLogTestScenario(2);
+    std::stringstream log1;
+    recordEventLogTestRun(first, log1);
+    deleteTestStations(first);
+    clearGlobalQueues();
+    
+    std::vector<Workstation*> second = loadEventLogTestScenario(1);
+    std::stringstream log2;
+    recordEventLogTestRun(second, log2);
+    deleteTestStations(second);
+    clearGlobalQueues();
+    
+    EventLogReader reader1(log1);
+    EventLogReader reader2(log2);
+    LoggedEvent event1;
+    LoggedEvent event2;
+    bool diverged = false;
+    while (!diverged && reader1.next(event1) && reader2.next(event2)) {
+        diverged = event1 != event2;
+    }
+    
+    // With one lamp Alice cannot get her second one and finishes early
+    CHECK(diverged);
+    CHECK_EQ(reader2.describe(event2), "3: Incomplete Alice, Office at Lamp");
+    
+    std::stringstream garbage("definitely not a log");
+    CHECK_THROWS_AS(EventLogReader bad(garbage), std::string);
+    
+    Utilities::setDelimiter(originalDelimiter);
+}
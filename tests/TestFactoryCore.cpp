@@ -0,0 +1,49 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "FactoryCore.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using namespace seneca;
+using namespace seneca::test;
+
+TEST_CASE("FactoryCore - Version") {
+    std::string version = getFactoryCoreVersion();
+    CHECK_FALSE(version.empty());
+    CHECK_EQ(std::count(version.begin(), version.end(), '.'), 2);
+}
+
+TEST_CASE("FactoryCore - Repeated In-Process Runs") {
+    std::string stations1 = writeTestFile("temp_core_stations1.txt",
+        "Desk,100,2,Office desk\n");
+    std::string stations2 = writeTestFile("temp_core_stations2.txt",
+        "Chair|200|5|Office chair\n");
+    std::string orders = writeTestFile("temp_core_orders.txt",
+        "Alice|Office|Desk|Chair\n"
+        "Bob|Office|Desk|Chair\n"
+        "Carol|Office|Desk\n");
+    std::string line = writeTestFile("temp_core_line.txt",
+        "Desk|Chair\n"
+        "Chair\n");
+
+    Scenario scenario = loadScenario(stations1, stations2, orders, line);
+    std::remove(stations1.c_str());
+    std::remove(stations2.c_str());
+    std::remove(orders.c_str());
+    std::remove(line.c_str());
+    CHECK(scenario.getLine() == std::vector<std::string>{"Desk", "Chair"});
+
+    SimulationContext first(scenario);
+    SimulationResult expected = first.fastForward();
+    CHECK_EQ(expected.m_completed, 2u);
+    CHECK_EQ(expected.m_incomplete, 1u);
+
+    // Every context starts from the scenario, never from an earlier run
+    for (int i = 0; i < 1000; i++) {
+        SimulationContext context(scenario);
+        SimulationResult result = context.fastForward();
+        CHECK_EQ(result.m_completed, expected.m_completed);
+        CHECK_EQ(result.m_iterations, expected.m_iterations);
+    }
+}
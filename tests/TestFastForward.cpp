@@ -0,0 +1,166 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "FastForward.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    struct FastForwardTestScenario {
+        std::vector<std::string> stations;	// comma-delimited records, in line order
+        std::vector<std::string> orders;	// pipe-delimited records
+    };
+
+    std::vector<Workstation*> loadFastForwardTestScenario(const FastForwardTestScenario& scenario) {
+        return loadTestStations(scenario.stations, scenario.orders);
+    }
+
+    // Everything the two engines must agree on, as text
+    std::string describeFastForwardTestResults(const std::vector<Workstation*>& stations, size_t iterations) {
+        std::ostringstream oss;
+        oss << "iterations " << iterations << "\n";
+        for (const auto& order : g_completed) {
+            oss << "#" << order.getId() << " ";
+            order.display(oss);
+        }
+        oss << "--\n";
+        for (const auto& order : g_incomplete) {
+            oss << "#" << order.getId() << " ";
+            order.display(oss);
+        }
+        oss << "--\n";
+        for (const auto* station : stations) {
+            oss << station->getItemName() << " " << station->getSerialNumber() << " " << station->getQuantity() << "\n";
+        }
+        return oss.str();
+    }
+
+    void compareEngines(const FastForwardTestScenario& scenario) {
+        clearGlobalQueues();
+        std::vector<Workstation*> ticked = loadFastForwardTestScenario(scenario);
+        LineManager manager(ticked);
+        std::ostringstream log;
+        while (!manager.run(log));
+        std::string expected = describeFastForwardTestResults(ticked, manager.getIterationCount());
+        
+        clearGlobalQueues();
+        std::vector<Workstation*> forwarded = loadFastForwardTestScenario(scenario);
+        size_t iterations = fastForward(forwarded);
+        std::string actual = describeFastForwardTestResults(forwarded, iterations);
+        
+        CHECK_EQ(actual, expected);
+        
+        for (auto* station : ticked) delete station;
+        for (auto* station : forwarded) delete station;
+        clearGlobalQueues();
+    }
+
+    // Random lines with scarce stock, duplicate stations, and items nobody stocks
+    FastForwardTestScenario makeRandomFastForwardTestScenario(std::mt19937& random) {
+        const std::vector<std::string> items = {"Desk", "Chair", "Lamp", "Shelf", "Sofa", "Rug"};
+        FastForwardTestScenario scenario;
+        
+        size_t stationCount = 1 + random() % 6;
+        for (size_t i = 0; i < stationCount; i++) {
+            scenario.stations.push_back(items[random() % 5] + "," + std::to_string(100 * (i + 1)) + "," + std::to_string(random() % 5) + ",Item");
+        }
+        
+        size_t orderCount = random() % 8;
+        for (size_t i = 0; i < orderCount; i++) {
+            std::string record = "Customer " + std::to_string(i) + "|Product";
+            size_t itemCount = 1 + random() % 5;
+            for (size_t j = 0; j < itemCount; j++) {
+                record += "|" + items[random() % items.size()];
+            }
+            scenario.orders.push_back(record);
+        }
+        return scenario;
+    }
+}
+
+TEST_CASE("FastForward - Matches Tick Engine On Sample Data") {
+    char originalDelimiter = Utilities::getDelimiter();
+    
+    FastForwardTestScenario scenario;
+    scenario.stations = {
+        "Bed,123456,5,Queen size bed with headboard",
+        "Dresser,56789,7,6-Drawer Unit",
+        "Armchair,654321,10,Upholstered Wing Chair",
+        "Nighttable,887,5,Nightstand with 2 drawers",
+        "Desk,459214,2,6-foot worktable",
+        "Office Chair,147852,20,High-back carpet-rollers",
+        "Filing Cabinet,987654,5,3-drawer filing cabinet",
+        "Bookcase,987,5,5-shelf open bookcase"
+    };
+    scenario.orders = {
+        "Cornel B.|1-Room Home Office|Office Chair|Desk|Bookcase|Bookcase|Filing Cabinet",
+        "Chris S.|Bedroom|Bed|Armchair|Nighttable|Dresser|Nighttable",
+        "John M.|Kids Bedroom|Bed|Bed|Bed|Bed|Nighttable|Nighttable|Dresser|Desk",
+        "Hong H.|1-Room Office|Desk|Office Chair|Office Chair|Filing Cabinet|Filing Cabinet|Filing Cabinet|Bookcase",
+        "Rania A.|2-Room Home Office and Bedroom|Desk|Desk|Office Chair|Bed|Office Chair|Office Chair|Nighttable|Armchair|Dresser"
+    };
+    compareEngines(scenario);
+    
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("FastForward - Matches Tick Engine On Random Scenarios") {
+    char originalDelimiter = Utilities::getDelimiter();
+    
+    std::mt19937 random(2024);
+    for (int trial = 0; trial < 300; trial++) {
+        CAPTURE(trial);
+        compareEngines(makeRandomFastForwardTestScenario(random));
+    }
+    
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("FastForward - Matches Tick Engine On Long Lines") {
+    char originalDelimiter = Utilities::getDelimiter();
+    
+    // Over 512 stations per item, so fastForward keeps its departure times
+    // as steps, with short orders that pass most stations without a fill
+    std::mt19937 random(7);
+    for (int trial = 0; trial < 20; trial++) {
+        CAPTURE(trial);
+        FastForwardTestScenario scenario;
+        size_t stationCount = 1600 + random() % 400;
+        for (size_t i = 0; i < stationCount; i++) {
+            scenario.stations.push_back("Item" + std::to_string(random() % 900) + "," + std::to_string(100 * (i + 1)) + "," + std::to_string(random() % 4) + ",Item");
+        }
+        size_t orderCount = 1 + random() % 30;
+        for (size_t i = 0; i < orderCount; i++) {
+            std::string record = "Customer " + std::to_string(i) + "|Product";
+            size_t itemCount = 1 + random() % 2;
+            for (size_t j = 0; j < itemCount; j++) {
+                record += "|Item" + std::to_string(random() % 1000);
+            }
+            scenario.orders.push_back(record);
+        }
+        compareEngines(scenario);
+    }
+    
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("FastForward - Empty Input") {
+    clearGlobalQueues();
+    
+    // LineManager::run needs one iteration to notice there is nothing to do
+    std::vector<Workstation*> noStations;
+    CHECK_EQ(fastForward(noStations), 1u);
+    
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Lonely|Order|Desk"));
+    CHECK_THROWS_AS(fastForward(noStations), std::string);
+    clearGlobalQueues();
+}
@@ -0,0 +1,76 @@
+#ifndef SENECA_TESTHELPERS_H
+#define SENECA_TESTHELPERS_H
+
+// Fixtures shared by the test files
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "CustomerOrder.h"
+#include "Scenario.h"
+#include "Utilities.h"
+#include "Workstation.h"
+
+namespace seneca {
+    namespace test {
+        inline void clearGlobalQueues() {
+            while (!g_pending.empty()) g_pending.pop_front();
+            while (!g_completed.empty()) g_completed.pop_front();
+            while (!g_incomplete.empty()) g_incomplete.pop_front();
+        }
+
+        inline std::string writeTestFile(const std::string& filename, const std::string& content) {
+            std::ofstream file(filename);
+            file << content;
+            file.close();
+            return filename;
+        }
+
+        inline std::string readTestFile(const std::string& filename) {
+            std::ifstream file(filename);
+            return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        // A Scenario loaded from comma-delimited stations, pipe-delimited orders
+        // and an AssemblyLine.txt layout, through temporary files
+        inline Scenario loadTestScenario(const std::string& stations, const std::string& orders, const std::string& line) {
+            std::string stationsFile = writeTestFile("temp_test_stations.txt", stations);
+            std::string ordersFile = writeTestFile("temp_test_orders.txt", orders);
+            std::string lineFile = writeTestFile("temp_test_line.txt", line);
+
+            Scenario scenario;
+            scenario.loadStations(stationsFile, ',');
+            scenario.loadOrders(ordersFile, '|');
+            scenario.loadLine(lineFile);
+
+            std::remove(stationsFile.c_str());
+            std::remove(ordersFile.c_str());
+            std::remove(lineFile.c_str());
+            return scenario;
+        }
+
+        // Workstations from comma-delimited records, with the pipe-delimited
+        // orders queued in g_pending; free them with deleteTestStations
+        inline std::vector<Workstation*> loadTestStations(const std::vector<std::string>& stations, const std::vector<std::string>& orders = {}) {
+            Utilities::setDelimiter(',');
+            std::vector<Workstation*> loaded;
+            for (const auto& record : stations) {
+                loaded.push_back(new Workstation(record));
+            }
+            Utilities::setDelimiter('|');
+            for (const auto& record : orders) {
+                g_pending.push_back(CustomerOrder(record));
+            }
+            return loaded;
+        }
+
+        inline void deleteTestStations(std::vector<Workstation*>& stations) {
+            for (auto* station : stations) delete station;
+            stations.clear();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,114 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "InventorySweep.h"
+#include "Scenario.h"
+#include "SimulationContext.h"
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    Scenario makeSweepTestScenario() {
+        return loadTestScenario(
+            "Desk,100000,0,Office desk\n"
+            "Chair,200000,0,Office chair\n",
+            "Alice|Office|Desk|Chair\n"
+            "Bob|Office|Desk|Chair\n"
+            "Carol|Office|Desk\n",
+            "Desk|Chair\n"
+            "Chair\n");
+    }
+}
+
+TEST_CASE("InventorySweep - Parse Axis") {
+    SweepAxis range = InventorySweep::parseAxis("Desk=2:5");
+    CHECK_EQ(range.m_station, "Desk");
+    CHECK(range.m_quantities == std::vector<size_t>{2, 3, 4, 5});
+    
+    SweepAxis stepped = InventorySweep::parseAxis("Office Chair=0:10:5");
+    CHECK_EQ(stepped.m_station, "Office Chair");
+    CHECK(stepped.m_quantities == std::vector<size_t>{0, 5, 10});
+    
+    SweepAxis list = InventorySweep::parseAxis("Bed=7,1,3");
+    CHECK(list.m_quantities == std::vector<size_t>{7, 1, 3});
+    
+    CHECK_THROWS_AS(InventorySweep::parseAxis("Desk"), std::string);
+    CHECK_THROWS_AS(InventorySweep::parseAxis("Desk=5:1"), std::string);
+    CHECK_THROWS_AS(InventorySweep::parseAxis("Desk=a,b"), std::string);
+
+    // Ranges ending near the top of size_t neither wrap nor expand without bound
+    std::string top = std::to_string(std::numeric_limits<size_t>::max());
+    SweepAxis last = InventorySweep::parseAxis("Desk=" + std::to_string(std::numeric_limits<size_t>::max() - 2) + ":" + top + ":2");
+    CHECK_EQ(last.m_quantities.size(), 2u);
+    CHECK_EQ(last.m_quantities.back(), std::numeric_limits<size_t>::max());
+    CHECK_THROWS_AS(InventorySweep::parseAxis("Desk=0:" + top), std::string);
+    CHECK_EQ(InventorySweep::parseAxis("Desk=0:" + top + ":" + top).m_quantities.size(), 2u);
+}
+
+TEST_CASE("InventorySweep - Runs Every Grid Point") {
+    Scenario scenario = makeSweepTestScenario();
+    
+    InventorySweep sweep(scenario, 3);
+    sweep.addAxis(InventorySweep::parseAxis("Desk=0:3"));
+    sweep.addAxis(InventorySweep::parseAxis("Chair=0,2"));
+    CHECK_EQ(sweep.getPointCount(), 8u);
+    CHECK_THROWS_AS(sweep.addAxis(InventorySweep::parseAxis("Sofa=1")), std::string);
+    
+    std::vector<SweepPoint> points = sweep.run();
+    REQUIRE_EQ(points.size(), 8u);
+    
+    // Each point must agree with a standalone run using the same quantities
+    for (size_t i = 0; i < points.size(); i++) {
+        InventoryOverlay overlay = sweep.getOverlay(i);
+        CHECK_EQ(points[i].m_quantities[0], overlay["Desk"]);
+        CHECK_EQ(points[i].m_quantities[1], overlay["Chair"]);
+        
+        SimulationContext context(scenario, overlay);
+        std::ostringstream quiet;
+        SimulationResult expected = context.run(quiet);
+        CHECK_EQ(points[i].m_result.m_completed, expected.m_completed);
+        CHECK_EQ(points[i].m_result.m_incomplete, expected.m_incomplete);
+    }
+    
+    // Desk=3, Chair=2 completes everything; Desk=0 completes nothing
+    CHECK_EQ(points.back().m_result.m_completed, 3u);
+    CHECK_EQ(points.front().m_result.m_completed, 0u);
+    
+    // The shared scenario is never modified
+    CHECK_EQ(scenario.findStation("Desk")->getQuantity(), 0u);
+}
+
+TEST_CASE("InventorySweep - Caps The Total Point Count") {
+    Scenario scenario = makeSweepTestScenario();
+
+    // 65536^4 wraps a 64-bit size_t to zero; the sweep must refuse it instead
+    InventorySweep sweep(scenario);
+    sweep.addAxis(InventorySweep::parseAxis("Desk=0:65535"));
+    CHECK_EQ(sweep.getPointCount(), 65536u);
+    CHECK_THROWS_AS(sweep.addAxis(InventorySweep::parseAxis("Chair=0:65535")), std::string);
+    CHECK_THROWS_AS(sweep.addAxis(InventorySweep::parseAxis("Chair=0:15")), std::string);
+    CHECK_EQ(sweep.getPointCount(), 65536u);
+
+    InventorySweep grid(scenario);
+    grid.addAxis(InventorySweep::parseAxis("Desk=0:999"));
+    grid.addAxis(InventorySweep::parseAxis("Chair=0:999"));
+    CHECK_EQ(grid.getPointCount(), 1000000u);
+    CHECK_THROWS_AS(grid.addAxis(InventorySweep::parseAxis("Desk=0,1")), std::string);
+    CHECK_EQ(grid.getPointCount(), 1000000u);
+}
+
+TEST_CASE("InventorySweep - Table Output") {
+    Scenario scenario = makeSweepTestScenario();
+    
+    InventorySweep sweep(scenario, 1);
+    sweep.addAxis(InventorySweep::parseAxis("Desk=1"));
+    
+    std::ostringstream oss;
+    sweep.writeTable(oss, sweep.run());
+    CHECK_EQ(oss.str().substr(0, oss.str().find('\n')), "Desk | Completed | Incomplete | Iterations");
+    CHECK(oss.str().find("   1 |         0 |          3 |") != std::string::npos);
+}
@@ -0,0 +1,86 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "LineOptimizer.h"
+#include "Scenario.h"
+#include "SimulationContext.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    // Orders mostly need Lamp, so a line that starts with Lamp drains faster
+    Scenario makeOptimizerTestScenario() {
+        return loadTestScenario(
+            "Desk,100000,10,Office desk\n"
+            "Chair,200000,10,Office chair\n"
+            "Lamp,300000,10,Desk lamp\n",
+            "A|Lights|Lamp|Lamp|Lamp\n"
+            "B|Lights|Lamp|Lamp|Lamp\n"
+            "C|Lights|Lamp|Lamp|Lamp\n"
+            "D|Office|Desk|Chair\n",
+            "Desk|Chair\n"
+            "Chair|Lamp\n"
+            "Lamp\n");
+    }
+}
+
+TEST_CASE("LineOptimizer - Never Worse Than Configured Line") {
+    Scenario scenario = makeOptimizerTestScenario();
+    
+    OptimizerOptions options;
+    options.m_workers = 2;
+    LineOptimizer optimizer(scenario, options);
+    
+    LineFitness original = optimizer.getFitness(scenario.getLine());
+    std::vector<std::string> best = optimizer.optimize();
+    LineFitness fitness = optimizer.getFitness(best);
+    
+    CHECK_EQ(best.size(), scenario.getLine().size());
+    CHECK_FALSE(LineOptimizer::isBetter(original, fitness));
+    CHECK_EQ(fitness.m_completed, 4u);
+    CHECK(fitness.m_iterations <= original.m_iterations);
+    
+    // The reported fitness must match an independent run of the winning line
+    SimulationContext context(scenario, best);
+    std::ostringstream quiet;
+    SimulationResult result = context.run(quiet);
+    CHECK_EQ(result.m_completed, fitness.m_completed);
+    CHECK_EQ(result.m_iterations, fitness.m_iterations);
+}
+
+TEST_CASE("LineOptimizer - Memoizes Fitness") {
+    Scenario scenario = makeOptimizerTestScenario();
+    LineOptimizer optimizer(scenario);
+    
+    optimizer.getFitness(scenario.getLine());
+    optimizer.getFitness(scenario.getLine());
+    CHECK_EQ(optimizer.getEvaluationCount(), 1u);
+    
+    // Three stations have only 3! orderings; restarts cannot exceed that
+    OptimizerOptions options;
+    options.m_restarts = 5;
+    LineOptimizer restarting(scenario, options);
+    restarting.optimize();
+    CHECK(restarting.getEvaluationCount() <= 6u);
+}
+
+TEST_CASE("LineOptimizer - A Failed Evaluation Is Not Memoized") {
+    Scenario scenario = makeOptimizerTestScenario();
+    LineOptimizer optimizer(scenario);
+    
+    std::vector<std::string> line = scenario.getLine();
+    line.push_back("Sofa");
+    CHECK_THROWS_AS(optimizer.getFitness(line), std::string);
+    CHECK_THROWS_AS(optimizer.getFitness(line), std::string);
+    CHECK_EQ(optimizer.getEvaluationCount(), 0u);
+}
+
+TEST_CASE("LineOptimizer - Writes AssemblyLine Format") {
+    std::ostringstream oss;
+    LineOptimizer::writeLine(oss, {"Lamp", "Desk", "Chair"});
+    CHECK_EQ(oss.str(), "Lamp|Desk\nDesk|Chair\nChair\n");
+}
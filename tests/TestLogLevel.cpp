@@ -0,0 +1,76 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "LogLevel.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    // Runs a small line to completion at `level` and returns its log
+    std::string runLogLevelTestLine(LogLevel level) {
+        char originalDelimiter = Utilities::getDelimiter();
+        LogLevel originalLevel = getLogLevel();
+        clearGlobalQueues();
+        
+        Utilities::setDelimiter(',');
+        std::vector<Workstation*> stations = {
+            new Workstation("Desk,100,1,Worktable"),
+            new Workstation("Lamp,200,2,Desk lamp")
+        };
+        Utilities::setDelimiter('|');
+        g_pending.push_back(CustomerOrder("Alice|Office|Desk|Lamp"));
+        g_pending.push_back(CustomerOrder("Bob|Study|Desk|Lamp"));
+        
+        setLogLevel(level);
+        std::ostringstream log;
+        {
+            LineManager manager(stations);
+            while (!manager.run(log));
+        }
+        setLogLevel(originalLevel);
+        
+        for (auto* station : stations) delete station;
+        clearGlobalQueues();
+        Utilities::setDelimiter(originalDelimiter);
+        return log.str();
+    }
+}
+
+TEST_CASE("LogLevel - Parse Names") {
+    CHECK(parseLogLevel("off") == LogLevel::Off);
+    CHECK(parseLogLevel("summary") == LogLevel::Summary);
+    CHECK(parseLogLevel("iteration") == LogLevel::Iteration);
+    CHECK(parseLogLevel("fill") == LogLevel::Fill);
+    CHECK_THROWS_AS(parseLogLevel("verbose"), std::string);
+}
+
+TEST_CASE("LogLevel - Default Is The Compiled Maximum") {
+    CHECK(getLogLevel() == maxLogLevel);
+}
+
+TEST_CASE("LogLevel - Each Level Filters The Run Log") {
+    std::string fill = runLogLevelTestLine(LogLevel::Fill);
+    std::string iteration = runLogLevelTestLine(LogLevel::Iteration);
+    
+    CHECK(runLogLevelTestLine(LogLevel::Off).empty());
+    CHECK(runLogLevelTestLine(LogLevel::Summary).empty());
+    CHECK(iteration.find("Filled") == std::string::npos);
+    
+    if (maxLogLevel >= LogLevel::Iteration) {
+        CHECK(iteration.find("Line Manager Iteration: 1\n") == 0);
+    }
+    if (maxLogLevel >= LogLevel::Fill) {
+        CHECK(fill.find("    Filled Alice, Office [Desk]\n") != std::string::npos);
+        CHECK(fill.find("    Unable to fill Bob, Study [Desk]\n") != std::string::npos);
+    }
+    else {
+        CHECK_EQ(fill, iteration);
+    }
+}
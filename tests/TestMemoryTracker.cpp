@@ -0,0 +1,76 @@
+#include "doctest.h"
+#include "MemoryTracker.h"
+#include "CustomerOrder.h"
+#include "Station.h"
+#include "Utilities.h"
+#include "Workstation.h"
+#include <sstream>
+#include <string>
+
+using namespace seneca;
+
+TEST_CASE("MemoryTracker - Counts Live And Peak Bytes") {
+    MemoryStats before = getMemoryTotals();
+    // The operator itself, since an optimizer may elide a new expression's allocation
+    void* block = ::operator new(100000);
+    MemoryStats during = getMemoryTotals();
+    CHECK_EQ(during.m_allocations, before.m_allocations + 1);
+    CHECK_EQ(during.m_bytes, before.m_bytes + 100000);
+    CHECK_EQ(during.m_live, before.m_live + 100000);
+    CHECK(during.m_peakLive >= during.m_live);
+    ::operator delete(block);
+    CHECK_EQ(getMemoryTotals().m_live, before.m_live);
+    CHECK(getMemoryTotals().m_peakLive >= before.m_live + 100000);
+}
+
+TEST_CASE("MemoryTracker - Tag Scopes Nest") {
+    {
+        MemoryTagScope outer(MemoryTag::LogFormatting);
+        {
+            MemoryTagScope inner(MemoryTag::DequeChunks);
+            CHECK_EQ(getMemoryTag(), MemoryTag::DequeChunks);
+        }
+        CHECK_EQ(getMemoryTag(), MemoryTag::LogFormatting);
+    }
+    CHECK_EQ(getMemoryTag(), MemoryTag::Other);
+}
+
+// The engine tags its allocations only in a MEMORY_TRACKING build
+#ifdef SENECA_MEMORY_TRACKING
+TEST_CASE("MemoryTracker - Attributes By Phase And Component") {
+    char originalDelimiter = Utilities::getDelimiter();
+    MemoryPhase originalPhase = getMemoryPhase();
+    setMemoryPhase(MemoryPhase::Configure);
+
+    MemoryStats stations = getMemoryStats(MemoryPhase::Configure, MemoryTag::StationStrings);
+    MemoryStats orders = getMemoryStats(MemoryPhase::Configure, MemoryTag::OrderItems);
+    MemoryStats queues = getMemoryStats(MemoryPhase::Configure, MemoryTag::DequeChunks);
+    {
+        Utilities::setDelimiter(',');
+        Workstation station("A-long-station-name-to-defeat-SSO,1,5,A description long enough to need the heap");
+        CHECK_EQ(getMemoryTag(), MemoryTag::Other);
+        Utilities::setDelimiter('|');
+        CustomerOrder order("Alice|Office|A-long-station-name-to-defeat-SSO");
+        station += std::move(order);
+        // Past the chunk the deque allocated when it was constructed
+        for (int i = 0; i < 64; i++) station += CustomerOrder();
+
+        CHECK(getMemoryStats(MemoryPhase::Configure, MemoryTag::StationStrings).m_allocations >= stations.m_allocations + 2);
+        // The item array and the item
+        CHECK(getMemoryStats(MemoryPhase::Configure, MemoryTag::OrderItems).m_allocations >= orders.m_allocations + 2);
+        CHECK(getMemoryStats(MemoryPhase::Configure, MemoryTag::DequeChunks).m_allocations > queues.m_allocations);
+    }
+    // Everything the station and order held has been freed again
+    CHECK_EQ(getMemoryStats(MemoryPhase::Configure, MemoryTag::StationStrings).m_live, stations.m_live);
+    CHECK_EQ(getMemoryStats(MemoryPhase::Configure, MemoryTag::OrderItems).m_live, orders.m_live);
+    CHECK(getMemoryPhasePeak(MemoryPhase::Configure) > 0);
+
+    std::ostringstream report;
+    writeMemoryReport(report);
+    CHECK(report.str().rfind("Memory Report (bytes):\nAllocations ", 0) == 0);
+    CHECK(report.str().find("\nconfigure  station-strings") != std::string::npos);
+
+    setMemoryPhase(originalPhase);
+    Utilities::setDelimiter(originalDelimiter);
+}
+#endif
@@ -0,0 +1,117 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "Metrics.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+TEST_CASE("LogHistogram - Power Of Two Buckets") {
+    CHECK_EQ(LogHistogram::bucketOf(0), 0u);
+    CHECK_EQ(LogHistogram::bucketOf(1), 1u);
+    CHECK_EQ(LogHistogram::bucketOf(2), 2u);
+    CHECK_EQ(LogHistogram::bucketOf(3), 2u);
+    CHECK_EQ(LogHistogram::bucketOf(4), 3u);
+    CHECK_EQ(LogHistogram::bucketOf(UINT64_MAX), 64u);
+    CHECK_EQ(LogHistogram::bucketHigh(64), UINT64_MAX);
+    
+    LogHistogram histogram;
+    for (uint64_t value : {0, 1, 1, 5, 6, 100}) histogram.record(value);
+    CHECK_EQ(histogram.getCount(), 6u);
+    CHECK_EQ(histogram.getMax(), 100u);
+    CHECK_EQ(histogram.getMean(), doctest::Approx(113.0 / 6));
+    CHECK_EQ(histogram.getBucket(3), 2u);
+    CHECK_EQ(histogram.getPercentile(0.5), 1u);
+    CHECK_EQ(histogram.getPercentile(1.0), 100u);
+    
+    std::ostringstream oss;
+    histogram.display(oss);
+    CHECK_EQ(oss.str(), "[0] 1  [1] 2  [4-7] 2  [64-127] 1");
+}
+
+TEST_CASE("QueueSeries - Keeps The Shape Of A Run") {
+    // A queue that builds up and drains again
+    QueueSeries series;
+    for (uint64_t length = 0; length < 10; length++) series.record(length);
+    for (uint64_t length = 10; length-- > 0;) series.record(length);
+    CHECK_EQ(series.getWindow(), 1u);
+    CHECK_EQ(series.getPointCount(), 20u);
+    std::ostringstream oss;
+    series.display(oss);
+    CHECK_EQ(oss.str(), "0 1 2 3 4 5 6 7 8 9 9 8 7 6 5 4 3 2 1 0");
+
+    // Longer runs merge neighbouring windows and keep their peaks
+    QueueSeries longRun;
+    for (uint64_t i = 0; i < 100; i++) longRun.record(i == 50 ? 40 : i % 3);
+    CHECK_EQ(longRun.getWindow(), 4u);
+    CHECK_EQ(longRun.getPointCount(), 25u);
+    CHECK_EQ(longRun.getPoint(12), 40u);
+    CHECK_EQ(longRun.getPoint(0), 2u);
+    CHECK_EQ(longRun.getPoint(24), 2u);
+
+    std::ostringstream empty;
+    QueueSeries().display(empty);
+    CHECK_EQ(empty.str(), "(none)");
+}
+
+TEST_CASE("MetricsCollector - Counts A Run") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    Utilities::setDelimiter(',');
+    std::vector<Workstation*> stations = {
+        new Workstation("Desk,100,1,Worktable"),
+        new Workstation("Lamp,200,5,Desk lamp")
+    };
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Alice|Office|Desk|Lamp"));
+    g_pending.push_back(CustomerOrder("Bob|Study|Desk|Lamp"));
+    g_pending.push_back(CustomerOrder("Carol|Den|Lamp"));
+    
+    LineManager manager(stations);
+    MetricsCollector metrics(manager);
+    manager.setObserver(&metrics);
+    std::ostringstream log;
+    while (!manager.run(log));
+    
+    const auto& desk = metrics.getStations()[0];
+    const auto& lamp = metrics.getStations()[1];
+    uint64_t iterations = metrics.getIterationCount();
+    CHECK_EQ(iterations, manager.getIterationCount());
+    
+    // Every iteration is exactly one of busy, starved or idle
+    for (const auto* station : {&desk, &lamp}) {
+        CHECK_EQ(station->m_busy + station->m_starved + station->m_idle, iterations);
+        CHECK_EQ(station->m_wait.getCount(), 3u);
+    }
+    CHECK_EQ(desk.m_name, "Desk");
+    CHECK_EQ(desk.m_fills, 1u);
+    CHECK_EQ(desk.m_stockOuts, 1u);		// Bob finds the desk stock gone
+    CHECK_EQ(desk.m_starved, 1u);
+    CHECK_EQ(lamp.m_fills, 3u);
+    CHECK_EQ(lamp.m_stockOuts, 0u);
+    CHECK_EQ(desk.m_queueMax, 1u);
+    
+    // Each order spends one fill phase at each station and two in the line
+    CHECK_EQ(desk.m_wait.getBucket(1), 3u);
+    CHECK_EQ(lamp.m_wait.getBucket(1), 3u);
+    CHECK_EQ(metrics.getLatency().getCount(), 3u);
+    CHECK_EQ(metrics.getLatency().getMax(), 2u);
+    
+    std::ostringstream report;
+    metrics.report(report);
+    CHECK(report.str().find("Station Metrics (" + std::to_string(iterations) + " iterations):") == 0);
+    CHECK(report.str().find("Order latency (iterations): 3 orders") != std::string::npos);
+    CHECK_EQ(desk.m_queue.getPointCount(), iterations);
+    CHECK(report.str().find("\nQueue length per station (peak of every 1 iteration):\n  Desk     ") != std::string::npos);
+    
+    for (auto* station : stations) delete station;
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
@@ -0,0 +1,56 @@
+#include "doctest.h"
+#include "PerfCounters.h"
+#include <sstream>
+#include <string>
+
+using namespace seneca;
+
+TEST_CASE("PerfSample - Arithmetic") {
+    PerfSample a;
+    PerfSample b;
+    for (size_t i = 0; i < PerfSample::c_events; i++) {
+        a.m_values[i] = 10 * (i + 1);
+        b.m_values[i] = i + 1;
+    }
+    PerfSample difference = a - b;
+    CHECK_EQ(difference.m_values[0], 9u);
+    CHECK_EQ(difference.m_values[3], 36u);
+    // A counter that moved backwards (e.g. scaling noise) never wraps
+    CHECK_EQ((b - a).m_values[2], 0u);
+    
+    difference += b;
+    CHECK_EQ(difference.m_values[1], 20u);
+    CHECK_EQ(std::string(getPerfEventName(2)), "cache-misses");
+}
+
+TEST_CASE("PerfPhases - Phases Accumulate") {
+    PerfPhases phases;
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 100000; i++) sum = sum + i;
+    phases.end("load");
+    phases.end("simulate");
+    phases.begin();
+    for (uint64_t i = 0; i < 100000; i++) sum = sum + i;
+    phases.end("load");
+    
+    REQUIRE_EQ(phases.getPhases().size(), 2u);
+    CHECK_EQ(phases.getPhases()[0].first, "load");
+    CHECK_EQ(phases.getPhases()[1].first, "simulate");
+    
+    std::ostringstream report;
+    phases.report(report);
+    if (phases.getCounters().isAnyAvailable()) {
+        // Wherever instructions can be counted, the loops executed some
+        if (phases.getCounters().isAvailable(1)) {
+            CHECK(phases.getPhases()[0].second.m_values[1] > 0);
+        }
+        CHECK(report.str().rfind("Hardware Counters (", 0) == 0);
+        CHECK(report.str().find("\ntotal ") != std::string::npos);
+    }
+    else {
+        // Unavailable counters read as zero and the report says why
+        CHECK_EQ(phases.getPhases()[0].second.m_values[0], 0u);
+        CHECK(report.str().rfind("Hardware Counters: unavailable (", 0) == 0);
+        CHECK_FALSE(phases.getCounters().getError().empty());
+    }
+}
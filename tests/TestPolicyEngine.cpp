@@ -0,0 +1,156 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "PolicyEngine.h"
+#include "FactoryCore.h"
+#include "ScenarioGenerator.h"
+#include "SimulationContext.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    Scenario makeEngineTestScenario() {
+        return loadTestScenario(
+            "Desk,100,2,Office desk\n"
+            "Chair,200,1,Office chair\n"
+            "Lamp,300,5,Desk lamp\n",
+            "Alice|Office|Desk|Chair|Chair\n"
+            "Bob|Office|Desk|Chair|Lamp\n"
+            "Carol|Office|Lamp\n"
+            "Dave|Study|Desk|Lamp|Lamp\n",
+            "Chair|Lamp\n"
+            "Desk|Chair\n"
+            "Lamp\n");
+    }
+
+    Scenario makeGeneratedScenario(const GeneratorSpec& spec) {
+        ScenarioGenerator generator(spec);
+        std::ostringstream stations, orders, line;
+        generator.writeStations(stations, 0, generator.getItems().size(), ',');
+        generator.writeOrders(orders);
+        generator.writeLine(line);
+        return loadTestScenario(stations.str(), orders.str(), line.str());
+    }
+
+    std::string describeOrders(const std::deque<CustomerOrder>& orders) {
+        std::ostringstream os;
+        for (const auto& order : orders) {
+            os << order.getId() << " ";
+            order.display(os);
+        }
+        return os.str();
+    }
+
+    // The reference run: LineManager, ticked by SimulationContext
+    void checkMatchesLineManager(const Scenario& scenario) {
+        SimulationContext context(scenario);
+        std::ostringstream expectedLog;
+        SimulationResult expected = context.run(expectedLog);
+
+        PolicyEngine<FillOne, FifoQueue, LogOn> engine(scenario);
+        std::ostringstream log;
+        SimulationResult result = engine.run(log);
+
+        CHECK_EQ(log.str(), expectedLog.str());
+        CHECK_EQ(result.m_completed, expected.m_completed);
+        CHECK_EQ(result.m_incomplete, expected.m_incomplete);
+        CHECK_EQ(result.m_iterations, expected.m_iterations);
+        CHECK_EQ(describeOrders(engine.getCompleted()), describeOrders(context.getCompleted()));
+        CHECK_EQ(describeOrders(engine.getIncomplete()), describeOrders(context.getIncomplete()));
+        REQUIRE_EQ(engine.getStations().size(), context.getStations().size());
+        for (size_t i = 0; i < engine.getStations().size(); i++) {
+            CHECK_EQ(engine.getStations()[i].getQuantity(), context.getStations()[i]->getQuantity());
+        }
+
+        FastEngine fast(scenario);
+        std::ostringstream quiet;
+        SimulationResult fastResult = fast.run(quiet);
+        CHECK(quiet.str().empty());
+        CHECK_EQ(fastResult.m_completed, expected.m_completed);
+        CHECK_EQ(fastResult.m_iterations, expected.m_iterations);
+    }
+}
+
+TEST_CASE("PolicyEngine - Default Policies Match LineManager") {
+    checkMatchesLineManager(makeEngineTestScenario());
+
+    for (uint64_t seed = 1; seed <= 20; seed++) {
+        GeneratorSpec spec;
+        spec.m_itemTypes = 6;
+        spec.m_orders = 40;
+        spec.m_stock = 0.6;
+        spec.m_lineLength = 4;
+        spec.m_seed = seed;
+        CAPTURE(seed);
+        checkMatchesLineManager(makeGeneratedScenario(spec));
+    }
+}
+
+TEST_CASE("PolicyEngine - Fill All") {
+    Scenario scenario = makeEngineTestScenario();
+    std::unique_ptr<LineEngine> one = makeLineEngine(parseEnginePolicies("quiet"), scenario, scenario.getLine());
+    std::unique_ptr<LineEngine> all = makeLineEngine(parseEnginePolicies("fill-all,quiet"), scenario, scenario.getLine());
+    std::ostringstream log;
+    SimulationResult oneResult = one->run(log);
+    SimulationResult allResult = all->run(log);
+
+    // Every order is served the same stock; filling in one visit only saves iterations
+    CHECK_EQ(allResult.m_completed, oneResult.m_completed);
+    CHECK(allResult.m_iterations <= oneResult.m_iterations);
+
+    PolicyEngine<FillAll, FifoQueue, LogOn> engine(loadTestScenario(
+        "Lamp,300,5,Desk lamp\n", "Dave|Study|Lamp|Lamp|Lamp\n", "Lamp\n"));
+    std::ostringstream fillLog;
+    SimulationResult result = engine.run(fillLog);
+    CHECK_EQ(result.m_completed, 1u);
+    CHECK_EQ(result.m_iterations, 1u);
+    CHECK_EQ(fillLog.str(),
+        "Line Manager Iteration: 1\n"
+        "    Filled Dave, Study [Lamp]\n"
+        "    Filled Dave, Study [Lamp]\n"
+        "    Filled Dave, Study [Lamp]\n");
+}
+
+TEST_CASE("PolicyEngine - Priority Queue Serves Nearly Finished Orders First") {
+    // Both orders reach Lamp together; Carol needs one item and Bob three
+    Scenario scenario = loadTestScenario(
+        "Desk,100,5,Office desk\n"
+        "Lamp,300,5,Desk lamp\n",
+        "Bob|Office|Lamp|Lamp|Lamp\n"
+        "Carol|Office|Lamp\n",
+        "Desk|Lamp\n"
+        "Lamp\n");
+
+    PolicyEngine<FillOne, PriorityQueue, LogOff> priority(scenario);
+    PolicyEngine<FillOne, FifoQueue, LogOff> fifo(scenario);
+    std::ostringstream log;
+    priority.run(log);
+    fifo.run(log);
+
+    REQUIRE_EQ(priority.getCompleted().size(), 2u);
+    REQUIRE_EQ(fifo.getCompleted().size(), 2u);
+    CHECK_EQ(fifo.getCompleted().front().getName(), "Bob");
+    CHECK_EQ(priority.getCompleted().front().getName(), "Carol");
+    CHECK_EQ(priority.getCompleted().front().getId(), 2u);
+}
+
+TEST_CASE("PolicyEngine - Overlay And Errors") {
+    Scenario scenario = makeEngineTestScenario();
+    FastEngine empty(scenario, scenario.getLine(), InventoryOverlay{{"Desk", 0}});
+    std::ostringstream log;
+    SimulationResult result = empty.run(log);
+    CHECK_EQ(result.m_completed, 1u);
+    CHECK_EQ(empty.getStations()[0].getQuantity(), 0u);
+
+    CHECK_THROWS_AS(FastEngine(scenario, {"Sofa"}), std::string);
+    CHECK_THROWS_AS(FastEngine(scenario, std::vector<std::string>()), std::string);
+    CHECK_THROWS_AS(parseEnginePolicies("fill-one,lifo"), std::string);
+
+    EnginePolicies policies = parseEnginePolicies("fill-all,priority,quiet");
+    CHECK(policies.m_fillAll);
+    CHECK(policies.m_priority);
+    CHECK_FALSE(policies.m_logging);
+}
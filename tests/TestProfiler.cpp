@@ -0,0 +1,96 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "Profiler.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    const ProfileZone* findProfileZone(const char* name) {
+        for (const auto* zone : getProfileZones()) {
+            if (std::strcmp(zone->m_name, name) == 0) return zone;
+        }
+        return nullptr;
+    }
+}
+
+TEST_CASE("Profiler - Zones And Counters") {
+    resetProfile();
+    ProfileZone& timed = getProfileZone("test.zone", true);
+    ProfileZone& counted = getProfileZone("test.counter", false);
+    for (int i = 0; i < 3; i++) {
+        ScopedZone scope(timed);
+        counted.m_calls.fetch_add(1);
+        counted.m_total.fetch_add(5);
+    }
+    CHECK_EQ(&getProfileZone("test.zone", true), findProfileZone("test.zone"));
+
+    const ProfileZone* zone = findProfileZone("test.zone");
+    const ProfileZone* counter = findProfileZone("test.counter");
+    REQUIRE(zone != nullptr);
+    REQUIRE(counter != nullptr);
+    CHECK(zone->m_timed);
+    CHECK_FALSE(counter->m_timed);
+    CHECK_EQ(zone->m_calls.load(), 3u);
+    CHECK_EQ(counter->m_calls.load(), 3u);
+    CHECK_EQ(counter->m_total.load(), 15u);
+    CHECK(getProfileClockRate() > 0);
+
+    resetProfile();
+    CHECK_EQ(zone->m_calls.load(), 0u);
+    CHECK_EQ(counter->m_total.load(), 0u);
+}
+
+// The zones in the engine exist only in a PROFILING build
+#ifdef SENECA_PROFILING
+TEST_CASE("Profiler - Run Phases") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+
+    Utilities::setDelimiter(',');
+    std::vector<Workstation*> stations = {
+        new Workstation("Desk,100,1,Worktable"),
+        new Workstation("Lamp,200,5,Desk lamp")
+    };
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Alice|Office|Desk|Lamp"));
+    g_pending.push_back(CustomerOrder("Bob|Study|Desk|Lamp"));
+
+    resetProfile();
+    size_t iterations = 0;
+    {
+        LineManager manager(stations);
+        std::ostringstream log;
+        while (!manager.run(log));
+        iterations = manager.getIterationCount();
+    }
+
+    REQUIRE(findProfileZone("run") != nullptr);
+    CHECK_EQ(findProfileZone("line.construct")->m_calls.load(), 1u);
+    CHECK_EQ(findProfileZone("run")->m_calls.load(), iterations);
+    CHECK_EQ(findProfileZone("run.fill")->m_calls.load(), iterations);
+    CHECK_EQ(findProfileZone("run.move")->m_calls.load(), iterations);
+    CHECK_EQ(findProfileZone("run.admit")->m_calls.load(), 2u);
+    CHECK_EQ(findProfileZone("orders.admitted")->m_total.load(), 2u);
+
+    std::ostringstream report;
+    writeProfile(report);
+    std::string text = report.str();
+    CHECK(text.rfind("Phase Breakdown (", 0) == 0);
+    CHECK(text.find("\nrun.fill ") != std::string::npos);
+    CHECK(text.find("Counter") != std::string::npos);
+    CHECK(text.find("\norders.admitted ") != std::string::npos);
+
+    for (auto* station : stations) delete station;
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+#endif
@@ -0,0 +1,99 @@
+#include "doctest.h"
+#include "ReportWriter.h"
+#include "CustomerOrder.h"
+#include "Station.h"
+#include "Utilities.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+
+namespace {
+    // One filled and one missing item; the name needs quoting in CSV and escaping in JSON
+    struct ReportTestRun {
+        std::deque<CustomerOrder> completed;
+        std::deque<CustomerOrder> incomplete;
+        std::vector<std::unique_ptr<Station>> stations;
+
+        ReportTestRun() {
+            char originalDelimiter = Utilities::getDelimiter();
+            Utilities::setDelimiter('|');
+            completed.push_back(CustomerOrder("Alice|Office|Desk"));
+            incomplete.push_back(CustomerOrder("Bob \"Jr\", Esq.|Study|Desk|Lamp"));
+            Utilities::setDelimiter(originalDelimiter);
+
+            stations.push_back(std::make_unique<Station>("Desk", 100, 3, "Office desk"));
+            stations.push_back(std::make_unique<Station>("Lamp", 200, 0, "Desk lamp, brass"));
+            completed.front().setId(1);
+            completed.front().fillItemAt(0, *stations[0]);
+            incomplete.front().setId(2);
+            incomplete.front().fillItemAt(0, *stations[0]);
+        }
+    };
+}
+
+TEST_CASE("ReportWriter - Formats") {
+    CHECK_EQ(parseReportFormat("csv"), ReportFormat::Csv);
+    CHECK_EQ(parseReportFormat("jsonl"), ReportFormat::JsonLines);
+    CHECK_THROWS_AS(parseReportFormat("xml"), std::string);
+    CHECK_EQ(getReportFormat("out/results.csv"), ReportFormat::Csv);
+    CHECK_EQ(getReportFormat("results.ndjson"), ReportFormat::JsonLines);
+    CHECK_THROWS_AS(getReportFormat("results.txt"), std::string);
+}
+
+TEST_CASE("ReportWriter - CSV") {
+    ReportTestRun run;
+    std::ostringstream os;
+    ReportWriter writer(os, ReportFormat::Csv);
+    writer.writeResults(run.completed, run.incomplete, run.stations);
+
+    std::string desk = std::to_string(run.stations[0]->getId());
+    std::string lamp = std::to_string(run.stations[1]->getId());
+    CHECK_EQ(os.str(),
+        "record,id,name,product,item,serial,filled,quantity,description\n"
+        "completed,1,Alice,Office,Desk,100,1,,\n"
+        "incomplete,2,\"Bob \"\"Jr\"\", Esq.\",Study,Desk,101,1,,\n"
+        "incomplete,2,\"Bob \"\"Jr\"\", Esq.\",Study,Lamp,,0,,\n"
+        "station," + desk + ",Desk,,,102,,1,Office desk\n"
+        "station," + lamp + ",Lamp,,,200,,0,\"Desk lamp, brass\"\n");
+}
+
+TEST_CASE("ReportWriter - CSV Order Without Items") {
+    char originalDelimiter = Utilities::getDelimiter();
+    Utilities::setDelimiter('|');
+    std::deque<CustomerOrder> completed;
+    std::deque<CustomerOrder> incomplete;
+    completed.push_back(CustomerOrder("Zed|Nothing"));
+    incomplete.push_back(CustomerOrder("Amy, Jr|Nothing"));
+    Utilities::setDelimiter(originalDelimiter);
+    completed.front().setId(1);
+    incomplete.front().setId(2);
+
+    std::vector<std::unique_ptr<Station>> stations;
+
+    std::ostringstream os;
+    ReportWriter writer(os, ReportFormat::Csv);
+    writer.writeResults(completed, incomplete, stations);
+    CHECK_EQ(os.str(),
+        "record,id,name,product,item,serial,filled,quantity,description\n"
+        "completed,1,Zed,Nothing,,,,,\n"
+        "incomplete,2,\"Amy, Jr\",Nothing,,,,,\n");
+}
+
+TEST_CASE("ReportWriter - JSON Lines") {
+    ReportTestRun run;
+    std::ostringstream os;
+    ReportWriter writer(os, ReportFormat::JsonLines);
+    writer.writeResults(run.completed, run.incomplete, run.stations);
+
+    std::string desk = std::to_string(run.stations[0]->getId());
+    std::string lamp = std::to_string(run.stations[1]->getId());
+    CHECK_EQ(os.str(),
+        "{\"record\":\"completed\",\"id\":1,\"name\":\"Alice\",\"product\":\"Office\",\"items\":[{\"item\":\"Desk\",\"serial\":100,\"filled\":true}],\"missing\":[]}\n"
+        "{\"record\":\"incomplete\",\"id\":2,\"name\":\"Bob \\\"Jr\\\", Esq.\",\"product\":\"Study\",\"items\":[{\"item\":\"Desk\",\"serial\":101,\"filled\":true},"
+        "{\"item\":\"Lamp\",\"serial\":null,\"filled\":false}],\"missing\":[\"Lamp\"]}\n"
+        "{\"record\":\"station\",\"id\":" + desk + ",\"name\":\"Desk\",\"serial\":102,\"quantity\":1,\"description\":\"Office desk\"}\n"
+        "{\"record\":\"station\",\"id\":" + lamp + ",\"name\":\"Lamp\",\"serial\":200,\"quantity\":0,\"description\":\"Desk lamp, brass\"}\n");
+}
@@ -0,0 +1,154 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "ResultSink.h"
+#include "FastForward.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    const char* c_spillTestFile = "temp_spill.bin";
+
+    // Two desks for three desk orders, so one order ends incomplete
+    std::vector<Workstation*> loadSpillTestScenario() {
+        return loadTestStations({
+            "Desk,100,2,Office desk",
+            "Chair,200,5,Office chair"
+        }, {
+            "Alice|Office|Desk|Chair",
+            "Bob|Office|Desk|Chair|Chair",
+            "Carol|Office|Desk",
+            "Dave|Office|Chair"
+        });
+    }
+
+    std::string describeSpillTestOrders(const std::deque<CustomerOrder>& orders) {
+        std::ostringstream oss;
+        for (const auto& order : orders) {
+            oss << "#" << order.getId() << " ";
+            order.display(oss);
+        }
+        return oss.str();
+    }
+
+    std::string describeSpillTestFile(bool completed) {
+        std::ostringstream oss;
+        readSpillFile(c_spillTestFile, completed, [&](const CustomerOrder& order) {
+            oss << "#" << order.getId() << " ";
+            order.display(oss);
+        });
+        return oss.str();
+    }
+}
+
+TEST_CASE("ResultSink - Spill File Matches In-Memory Results") {
+    clearGlobalQueues();
+    std::vector<Workstation*> kept = loadSpillTestScenario();
+    LineManager keeping(kept);
+    std::ostringstream log;
+    while (!keeping.run(log));
+    std::string completed = describeSpillTestOrders(g_completed);
+    std::string incomplete = describeSpillTestOrders(g_incomplete);
+    REQUIRE_EQ(g_completed.size(), 3u);
+    REQUIRE_EQ(g_incomplete.size(), 1u);
+
+    clearGlobalQueues();
+    std::vector<Workstation*> spilled = loadSpillTestScenario();
+    LineManager spilling(spilled);
+    {
+        SpillFileSink sink(c_spillTestFile);
+        spilling.setResultSink(&sink);
+        std::ostringstream spillLog;
+        while (!spilling.run(spillLog));
+        sink.flush();
+
+        CHECK(g_completed.empty());
+        CHECK(g_incomplete.empty());
+        CHECK_EQ(sink.getCompletedCount(), 3u);
+        CHECK_EQ(sink.getIncompleteCount(), 1u);
+        CHECK_EQ(spilling.getIterationCount(), keeping.getIterationCount());
+        CHECK_EQ(spillLog.str(), log.str());
+    }
+    CHECK_EQ(describeSpillTestFile(true), completed);
+    CHECK_EQ(describeSpillTestFile(false), incomplete);
+
+    // Detaching the sink sends orders back to the global queues
+    spilling.setResultSink(nullptr);
+    clearGlobalQueues();
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Erin|Office|Chair"));
+    LineManager again(spilled);
+    while (!again.run(log));
+    CHECK_EQ(g_completed.size(), 1u);
+
+    for (auto* station : kept) delete station;
+    for (auto* station : spilled) delete station;
+    clearGlobalQueues();
+    std::remove(c_spillTestFile);
+}
+
+TEST_CASE("ResultSink - Fast Forward Spills") {
+    clearGlobalQueues();
+    std::vector<Workstation*> kept = loadSpillTestScenario();
+    size_t iterations = fastForward(kept);
+    std::string completed = describeSpillTestOrders(g_completed);
+    std::string incomplete = describeSpillTestOrders(g_incomplete);
+
+    clearGlobalQueues();
+    std::vector<Workstation*> spilled = loadSpillTestScenario();
+    {
+        SpillFileSink sink(c_spillTestFile);
+        CHECK_EQ(fastForward(spilled, &sink), iterations);
+        CHECK(g_completed.empty());
+        CHECK_EQ(sink.getCompletedCount() + sink.getIncompleteCount(), 4u);
+    }
+    CHECK_EQ(describeSpillTestFile(true), completed);
+    CHECK_EQ(describeSpillTestFile(false), incomplete);
+
+    for (auto* station : kept) delete station;
+    for (auto* station : spilled) delete station;
+    clearGlobalQueues();
+    std::remove(c_spillTestFile);
+}
+
+TEST_CASE("ResultSink - Rejects Other Files") {
+    CHECK_THROWS_AS(SpillFileReader("temp_spill_missing.bin"), std::string);
+
+    {
+        std::ofstream file(c_spillTestFile, std::ios::binary);
+        file << "not a spill file";
+    }
+    CHECK_THROWS_AS(SpillFileReader{ c_spillTestFile }, std::string);
+
+    // A record cut short is an error, not a quiet end of file
+    {
+        SpillFileSink sink(c_spillTestFile);
+        Utilities::setDelimiter('|');
+        sink.accept(CustomerOrder("Alice|Office|Desk"), false);
+    }
+    std::string content;
+    {
+        std::ifstream file(c_spillTestFile, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(c_spillTestFile, std::ios::binary | std::ios::trunc);
+        file << content.substr(0, content.size() - 4);
+    }
+    SpillFileReader reader(c_spillTestFile);
+    CustomerOrder order;
+    bool completed = true;
+    CHECK_THROWS_AS(reader.next(order, completed), std::string);
+    std::remove(c_spillTestFile);
+}
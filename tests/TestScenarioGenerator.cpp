@@ -0,0 +1,126 @@
+#include "doctest.h"
+#include "ScenarioGenerator.h"
+#include "Scenario.h"
+#include "SimulationContext.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+
+namespace {
+    std::string generateAll(const GeneratorSpec& spec) {
+        ScenarioGenerator generator(spec);
+        std::ostringstream oss;
+        generator.writeStations(oss, 0, generator.getItems().size(), ',');
+        generator.writeLine(oss);
+        generator.writeOrders(oss);
+        return oss.str();
+    }
+}
+
+TEST_CASE("ScenarioGenerator - Same Seed, Same Scenario") {
+    GeneratorSpec spec;
+    spec.m_itemTypes = 20;
+    spec.m_orders = 200;
+    spec.m_zipf = 1.1;
+    
+    std::string first = generateAll(spec);
+    CHECK_EQ(generateAll(spec), first);
+    
+    spec.m_seed = 2;
+    CHECK(generateAll(spec) != first);
+}
+
+TEST_CASE("ScenarioGenerator - Shapes The Orders") {
+    GeneratorSpec spec;
+    spec.m_itemTypes = 50;
+    spec.m_orders = 2000;
+    spec.m_minItems = 2;
+    spec.m_maxItems = 4;
+    spec.m_zipf = 1.5;
+    spec.m_lineLength = 30;
+    ScenarioGenerator generator(spec);
+    
+    CHECK_EQ(generator.getLine().size(), 30u);
+    CHECK_EQ(generator.getLineItems().size(), 30u);
+    
+    size_t orders = 0;
+    size_t mostPopular = 0;
+    size_t leastPopular = 0;
+    bool inRange = true;
+    generator.forEachOrder([&](const std::string& record) {
+        orders++;
+        size_t items = 0;
+        size_t pos = record.find('|', record.find('|') + 1);
+        while (pos != std::string::npos) {
+            size_t next = record.find('|', pos + 1);
+            std::string item = record.substr(pos + 1, next == std::string::npos ? std::string::npos : next - pos - 1);
+            if (item == "Item1") mostPopular++;
+            if (item == "Item50") leastPopular++;
+            items++;
+            pos = next;
+        }
+        inRange = inRange && items >= 2 && items <= 4;
+    });
+    CHECK_EQ(orders, 2000u);
+    CHECK(inRange);
+    CHECK(mostPopular > 20 * leastPopular);
+}
+
+TEST_CASE("ScenarioGenerator - Stock Follows Demand") {
+    GeneratorSpec spec;
+    spec.m_itemTypes = 4;
+    spec.m_orders = 1000;
+    spec.m_minItems = 2;
+    spec.m_maxItems = 2;
+    spec.m_stock = 0.5;
+    ScenarioGenerator generator(spec);
+    
+    // Uniform popularity: 2000 items over 4 types, half of it in stock
+    CHECK_EQ(generator.getStationRecord(0, ','), "Item1,100000,250,Synthetic item 1");
+    CHECK_EQ(generator.getStationRecord(3, '|'), "Item4|103000|250|Synthetic item 4");
+    
+    spec.m_minItems = 3;
+    CHECK_THROWS_AS(ScenarioGenerator{spec}, std::string);
+}
+
+TEST_CASE("ScenarioGenerator - Output Loads And Runs") {
+    GeneratorSpec spec;
+    spec.m_itemTypes = 12;
+    spec.m_orders = 100;
+    spec.m_zipf = 1.0;
+    spec.m_stock = 0.7;
+    ScenarioGenerator generator(spec);
+    
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "factory_generator_test";
+    std::filesystem::create_directories(directory);
+    {
+        std::ofstream stations1(directory / "Stations1.txt");
+        generator.writeStations(stations1, 0, 6, ',');
+        std::ofstream stations2(directory / "Stations2.txt");
+        generator.writeStations(stations2, 6, 12, '|');
+        std::ofstream orders(directory / "CustomerOrders.txt");
+        generator.writeOrders(orders);
+        std::ofstream line(directory / "AssemblyLine.txt");
+        generator.writeLine(line);
+    }
+    
+    Scenario scenario;
+    scenario.loadStations((directory / "Stations1.txt").string(), ',');
+    scenario.loadStations((directory / "Stations2.txt").string(), '|');
+    scenario.loadOrders((directory / "CustomerOrders.txt").string(), '|');
+    scenario.loadLine((directory / "AssemblyLine.txt").string());
+    std::filesystem::remove_all(directory);
+    
+    CHECK_EQ(scenario.getStations().size(), 12u);
+    CHECK_EQ(scenario.getOrders().size(), 100u);
+    CHECK(scenario.getLine() == generator.getLine());
+    
+    SimulationContext context(scenario);
+    SimulationResult result = context.fastForward();
+    CHECK_EQ(result.m_completed + result.m_incomplete, 100u);
+    CHECK(result.m_incomplete > 0);
+}
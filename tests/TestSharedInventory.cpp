@@ -0,0 +1,163 @@
+#include "doctest.h"
+#include "SharedInventory.h"
+#include "Utilities.h"
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace seneca;
+
+namespace {
+    // `orders` orders for a desk and a chair each, on a Desk -> Chair line
+    Scenario makeSharedTestLine(size_t orders, size_t desks = 100) {
+        Scenario scenario;
+        scenario.addStations({ Station("Desk", 100, desks, "Office desk"), Station("Chair", 500, 100, "Office chair") });
+        Utilities::setDelimiter('|');
+        std::vector<CustomerOrder> list;
+        for (size_t i = 0; i < orders; i++) {
+            list.push_back(CustomerOrder("Customer " + std::to_string(i) + "|Office|Desk|Chair"));
+        }
+        scenario.addOrders(list);
+        scenario.setLine({ "Desk", "Chair" });
+        return scenario;
+    }
+}
+
+TEST_CASE("SharedInventory - Equal Shares") {
+    SharedInventory inventory({ Station("Desk", 100, 10, "Office desk") }, 3, InventoryFairness::EqualShare);
+    REQUIRE_EQ(inventory.indexOf("Desk"), 0u);
+    CHECK_EQ(inventory.indexOf("Lamp"), inventory.getItemCount());
+
+    // 3 desks for each line and 1 in common
+    CHECK_EQ(inventory.getAvailable(0, 0), 4u);
+    StationReservation first = inventory.reserve(0, 0, 5);
+    CHECK_EQ(first.m_firstSerial, 100u);
+    CHECK_EQ(first.m_count, 4u);
+    CHECK_EQ(inventory.getAvailable(0, 1), 3u);
+    CHECK_EQ(inventory.getQuantity(0), 6u);
+
+    const InventoryContention& contention = inventory.getContention(0, 0);
+    CHECK_EQ(contention.m_requests, 1u);
+    CHECK_EQ(contention.m_wanted, 5u);
+    CHECK_EQ(contention.m_granted, 4u);
+    CHECK_EQ(contention.m_shortfalls, 1u);
+    CHECK_EQ(contention.m_fromPool, 1u);
+
+    // A finished line's share becomes common
+    inventory.finishLine(2);
+    CHECK_EQ(inventory.getAvailable(0, 0), 3u);
+    StationReservation second = inventory.reserve(0, 0, 3);
+    CHECK_EQ(second.m_firstSerial, 104u);
+    CHECK_EQ(second.m_count, 3u);
+    CHECK_EQ(inventory.reserve(0, 1, 3).m_count, 3u);
+    CHECK_EQ(inventory.getQuantity(0), 0u);
+    CHECK_EQ(inventory.getSerialNumber(0), 110u);
+
+    std::ostringstream os;
+    inventory.writeContention(os, 0);
+    CHECK_EQ(os.str(),
+        "Item | Requests |   Wanted |  Granted |    Short |  Retries | From pool\n"
+        "Desk |        2 |        8 |        7 |        1 |        0 |         4\n");
+}
+
+TEST_CASE("SharedInventory - First Come From Several Threads") {
+    const size_t stock = 20000;
+    SharedInventory inventory({ Station("Desk", 1000, stock, "Office desk") }, 4, InventoryFairness::FirstCome);
+
+    std::vector<std::vector<StationReservation>> granted(4);
+    std::vector<std::thread> threads;
+    for (size_t line = 0; line < granted.size(); line++) {
+        threads.emplace_back([&, line] {
+            for (size_t i = 0; ; i++) {
+                StationReservation reservation = inventory.reserve(0, line, 1 + (i + line) % 5);
+                if (reservation.m_count == 0) break;
+                granted[line].push_back(reservation);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t total = 0;
+    for (size_t line = 0; line < granted.size(); line++) {
+        for (const auto& reservation : granted[line]) ranges.emplace_back(reservation.m_firstSerial, reservation.m_count);
+        total += inventory.getContention(line, 0).m_granted;
+    }
+    std::sort(ranges.begin(), ranges.end());
+    size_t next = 1000;
+    for (const auto& range : ranges) {
+        CHECK_EQ(range.first, next);
+        next += range.second;
+    }
+    CHECK_EQ(next, 1000 + stock);
+    CHECK_EQ(total, stock);
+    CHECK_EQ(inventory.getQuantity(0), 0u);
+}
+
+TEST_CASE("SharedInventory - Stations Draw From It") {
+    SharedInventory inventory({ Station("Desk", 100, 4, "Office desk") }, 2, InventoryFairness::EqualShare);
+    Station desk("Desk", 900, 50, "Office desk");
+    Station lamp("Lamp", 300, 5, "Desk lamp");
+
+    CHECK(desk.drawFrom(&inventory, 1));
+    CHECK_FALSE(lamp.drawFrom(&inventory, 1));
+    CHECK_EQ(desk.getQuantity(), 2u);
+    CHECK_EQ(desk.getSerialNumber(), 100u);
+    CHECK_EQ(desk.reserve(3).m_count, 2u);
+    CHECK_EQ(inventory.getAvailable(0, 0), 2u);
+    CHECK_EQ(lamp.reserve(1).m_firstSerial, 300u);
+    CHECK_THROWS_AS(desk.drawFrom(&inventory, 2), std::string);
+
+    // Back on its own stock, untouched while it drew from the inventory
+    desk.drawFrom(nullptr, 0);
+    CHECK_EQ(desk.getQuantity(), 50u);
+    CHECK_EQ(desk.getSerialNumber(), 900u);
+}
+
+TEST_CASE("SharedInventory - Lines Share Scarce Stock") {
+    for (InventoryFairness fairness : { InventoryFairness::FirstCome, InventoryFairness::EqualShare }) {
+        CAPTURE(static_cast<int>(fairness));
+        Scenario stock = makeSharedTestLine(0, 12);
+        Scenario line = makeSharedTestLine(10);
+
+        SharedLineRunner runner(stock, fairness);
+        runner.addLine("a", line);
+        runner.addLine("b", line);
+        runner.addLine("c", line);
+        std::vector<SimulationResult> results = runner.run();
+        REQUIRE_EQ(results.size(), 3u);
+
+        // Twelve desks between thirty orders, each serial number used once
+        size_t completed = 0;
+        std::set<size_t> serials;
+        for (size_t i = 0; i < results.size(); i++) {
+            CHECK_EQ(results[i].m_completed + results[i].m_incomplete, 10u);
+            if (fairness == InventoryFairness::EqualShare) CHECK_GE(results[i].m_completed, 4u);
+            completed += results[i].m_completed;
+            for (const auto& order : runner.getLine(i).getCompleted()) {
+                CHECK(serials.insert(order.getItemSerialNumber(0)).second);
+            }
+            CHECK_EQ(runner.getInventory().getContention(i, 0).m_granted, results[i].m_completed);
+        }
+        CHECK_EQ(completed, 12u);
+        CHECK_EQ(*serials.begin(), 100u);
+        CHECK_EQ(*serials.rbegin(), 111u);
+        CHECK_EQ(runner.getInventory().getQuantity(0), 0u);
+        // Chairs go to every order, desk or not
+        CHECK_EQ(runner.getInventory().getQuantity(1), 100u - 30u);
+
+        std::ostringstream report;
+        runner.writeReport(report);
+        CHECK(report.str().rfind("Line a: ", 0) == 0);
+        CHECK(report.str().find("\nDesk  | Requests |") == std::string::npos);
+        CHECK(report.str().find("\nItem  | Requests |") != std::string::npos);
+        CHECK(report.str().find("\nDesk  | 000112 |    0\n") != std::string::npos);
+        CHECK_THROWS_AS(runner.run(), std::string);
+    }
+
+    CHECK_EQ(parseInventoryFairness("equal-share"), InventoryFairness::EqualShare);
+    CHECK_THROWS_AS(parseInventoryFairness("lottery"), std::string);
+}
@@ -0,0 +1,113 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "Scenario.h"
+#include "SimulationContext.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+// Helpers in anonymous namespace to avoid linking conflicts
+namespace {
+    Scenario makeContextTestScenario() {
+        return loadTestScenario(
+            "Desk,100000,2,Office desk\n"
+            "Chair,200000,1,Office chair\n"
+            "Lamp,300000,5,Desk lamp\n",
+            "Alice|Office|Desk|Chair\n"
+            "Bob|Office|Desk|Chair|Lamp\n"
+            "Charlie|Office|Lamp\n",
+            "Chair|Lamp\n"
+            "Desk|Chair\n"
+            "Lamp\n");
+    }
+}
+
+TEST_CASE("Scenario - Loads Stations, Orders and Line") {
+    char originalDelimiter = Utilities::getDelimiter();
+    
+    Scenario scenario = makeContextTestScenario();
+    
+    CHECK_EQ(scenario.getStations().size(), 3u);
+    CHECK_EQ(scenario.getOrders().size(), 3u);
+    
+    // The line is resolved into travel order, not file order
+    std::vector<std::string> expected = {"Desk", "Chair", "Lamp"};
+    CHECK(scenario.getLine() == expected);
+    
+    // Loading must not leak the file delimiter into the shared Utilities state
+    CHECK_EQ(Utilities::getDelimiter(), originalDelimiter);
+    
+    CHECK_THROWS_AS(scenario.setLine({"Desk", "Sofa"}), std::string);
+}
+
+TEST_CASE("SimulationContext - Matches LineManager Run") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    Scenario scenario = makeContextTestScenario();
+    
+    SimulationContext context(scenario);
+    std::ostringstream contextLog;
+    SimulationResult result = context.run(contextLog);
+    
+    // Run the same input through LineManager and the global queues directly
+    Utilities::setDelimiter(',');
+    std::vector<Workstation*> stations = {
+        new Workstation("Desk,100000,2,Office desk"),
+        new Workstation("Chair,200000,1,Office chair"),
+        new Workstation("Lamp,300000,5,Desk lamp")
+    };
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Alice|Office|Desk|Chair"));
+    g_pending.push_back(CustomerOrder("Bob|Office|Desk|Chair|Lamp"));
+    g_pending.push_back(CustomerOrder("Charlie|Office|Lamp"));
+    
+    LineManager manager(stations);
+    std::ostringstream managerLog;
+    while (!manager.run(managerLog));
+    
+    CHECK_EQ(contextLog.str(), managerLog.str());
+    CHECK_EQ(result.m_completed, g_completed.size());
+    CHECK_EQ(result.m_incomplete, g_incomplete.size());
+    CHECK_EQ(result.m_iterations, manager.getIterationCount());
+    CHECK_EQ(result.m_completed, 2u);
+    CHECK_EQ(result.m_incomplete, 1u);
+    
+    // The context works on its own copies of the stations
+    CHECK_EQ(context.findStation("Desk")->getQuantity(), 0u);
+    CHECK_EQ(scenario.findStation("Desk")->getQuantity(), 2u);
+    
+    for (auto* station : stations) {
+        delete station;
+    }
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("SimulationContext - Leaves Caller Queues Untouched") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    Scenario scenario = makeContextTestScenario();
+    
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Dave|Office|Desk"));
+    
+    SimulationContext context(scenario);
+    std::ostringstream oss;
+    context.run(oss);
+    
+    CHECK_EQ(g_pending.size(), 1u);
+    CHECK_EQ(g_completed.size(), 0u);
+    CHECK_EQ(g_incomplete.size(), 0u);
+    CHECK_EQ(context.getCompleted().size() + context.getIncomplete().size(), 3u);
+    
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
@@ -0,0 +1,205 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "SimulationServer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#endif
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    struct ServerTestFiles {
+        std::vector<std::string> files;
+        ServerTestFiles() {
+            files.push_back(writeTestFile("temp_server_stations1.txt", "Desk,100,2,Office desk\n"));
+            files.push_back(writeTestFile("temp_server_stations2.txt", "Chair|200|5|Office chair\n"));
+            files.push_back(writeTestFile("temp_server_orders.txt",
+                "Alice|Office|Desk|Chair\n"
+                "Bob|Office|Desk|Chair\n"
+                "Carol|Office|Desk\n"));
+            files.push_back(writeTestFile("temp_server_line.txt", "Desk|Chair\nChair\n"));
+        }
+        ~ServerTestFiles() {
+            for (const auto& file : files) std::remove(file.c_str());
+        }
+        std::string loadRequest(const std::string& name) const {
+            return "load " + name + " " + files[0] + " " + files[1] + " " + files[2] + " " + files[3];
+        }
+    };
+
+    std::string replyBody(const std::string& reply) {
+        REQUIRE(reply.rfind("ok ", 0) == 0);
+        size_t newline = reply.find('\n');
+        size_t length = std::stoul(reply.substr(3, newline - 3));
+        CHECK_EQ(reply.size(), newline + 1 + length);
+        return reply.substr(newline + 1);
+    }
+
+    // "job <id>\n" -> "<id>"
+    std::string jobId(const std::string& reply) {
+        std::string body = replyBody(reply);
+        REQUIRE(body.rfind("job ", 0) == 0);
+        return body.substr(4, body.size() - 5);
+    }
+}
+
+TEST_CASE("ThreadPool - Runs Every Task") {
+    std::atomic<int> total{0};
+    {
+        ThreadPool pool(4);
+        CHECK_EQ(pool.getWorkerCount(), 4u);
+        for (int i = 1; i <= 100; i++) {
+            pool.submit([&total, i]() { total += i; });
+        }
+    }
+    CHECK_EQ(total.load(), 5050);
+}
+
+TEST_CASE("SimulationServer - Splits Requests") {
+    CHECK(SimulationServer::splitRequest("run  home\t\"Office Chair=3\"\r") == std::vector<std::string>{"run", "home", "Office Chair=3"});
+    CHECK(SimulationServer::splitRequest("").empty());
+    CHECK_THROWS_AS(SimulationServer::splitRequest("run \"home"), std::string);
+}
+
+TEST_CASE("SimulationServer - Requests") {
+    ServerTestFiles files;
+    SimulationServer server(2);
+
+    CHECK_EQ(replyBody(server.handle(files.loadRequest("home"))), "loaded home: 2 stations, 3 orders\n");
+    CHECK_EQ(replyBody(server.handle("scenarios")), "home\n");
+
+    std::string run = jobId(server.handle("run home"));
+    std::string result = replyBody(server.handle("result " + run));
+    CHECK(result.rfind("result 2 1 ", 0) == 0);
+    CHECK(result.find("completed 1 Alice, Office\n") != std::string::npos);
+    CHECK(result.find("incomplete 3 Carol, Office\n") != std::string::npos);
+    CHECK(result.find("station 0 Desk\n") != std::string::npos);
+    CHECK_EQ(replyBody(server.handle("status " + run)), "done\n");
+
+    // Each job runs on fresh copies, so the first run left the scenario untouched
+    std::string again = jobId(server.handle("run home"));
+    std::string stocked = jobId(server.handle("run home Desk=3"));
+    CHECK_EQ(replyBody(server.handle("result " + again)), result);
+    CHECK(replyBody(server.handle("result " + stocked)).rfind("result 3 0 ", 0) == 0);
+
+    std::string sweep = jobId(server.handle("sweep home Desk=0:3"));
+    std::string table = replyBody(server.handle("result " + sweep));
+    CHECK(table.rfind("Desk | Completed | Incomplete | Iterations\n", 0) == 0);
+    CHECK_EQ(std::count(table.begin(), table.end(), '\n'), 5);
+
+    CHECK_EQ(replyBody(server.handle("forget " + run)), "forgot " + run + "\n");
+    CHECK(server.handle("status " + run).rfind("error Unknown job", 0) == 0);
+    CHECK(server.handle("run home Sofa=1").rfind("error Unknown station", 0) == 0);
+    CHECK(server.handle("sweep home Desk").rfind("error Invalid sweep axis", 0) == 0);
+    CHECK(server.handle("run attic").rfind("error Unknown scenario", 0) == 0);
+    CHECK(server.handle("load bad missing.txt missing.txt missing.txt missing.txt").rfind("error ", 0) == 0);
+    CHECK(server.handle("dance").rfind("error Unknown request", 0) == 0);
+
+    CHECK_EQ(replyBody(server.handle("unload home")), "unloaded home\n");
+    CHECK_EQ(replyBody(server.handle("scenarios")), "");
+    CHECK_FALSE(server.isStopping());
+    CHECK_EQ(replyBody(server.handle("shutdown")), "stopping\n");
+    CHECK(server.isStopping());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+namespace {
+    // Connects to a server that may still be starting; -1 if it never listens
+    int connectToServer(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        int client = -1;
+        for (int attempt = 0; attempt < 200 && client < 0; attempt++) {
+            client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (::connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                ::close(client);
+                client = -1;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        return client;
+    }
+
+    std::string requestOver(int client, const std::string& line) {
+        std::string message = line + "\n";
+        ::send(client, message.data(), message.size(), 0);
+        std::string reply;
+        char buffer[1024];
+        // Reads the status line, then as many bytes as it announces
+        for (;;) {
+            size_t newline = reply.find('\n');
+            if (newline != std::string::npos) {
+                if (reply.rfind("ok ", 0) != 0) break;
+                if (reply.size() >= newline + 1 + std::stoul(reply.substr(3, newline - 3))) break;
+            }
+            ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) break;
+            reply.append(buffer, static_cast<size_t>(received));
+        }
+        return reply;
+    }
+}
+
+TEST_CASE("SimulationServer - Unix Socket") {
+    ServerTestFiles files;
+    const std::string path = "temp_server.sock";
+    SimulationServer server(2);
+    std::thread serving([&]() { server.serve(path); });
+
+    int client = connectToServer(path);
+    REQUIRE(client >= 0);
+
+    replyBody(requestOver(client, files.loadRequest("home")));
+    std::string job = jobId(requestOver(client, "run home"));
+    CHECK(replyBody(requestOver(client, "result " + job)).rfind("result 2 1 ", 0) == 0);
+    CHECK_EQ(replyBody(requestOver(client, "shutdown")), "stopping\n");
+    ::close(client);
+
+    serving.join();
+    CHECK(std::ifstream(path).fail());
+}
+
+TEST_CASE("SimulationServer - Closed Connections Are Joined") {
+    const std::string path = "temp_server_churn.sock";
+    SimulationServer server(1);
+    std::thread serving([&]() { server.serve(path); });
+
+    for (int i = 0; i < 100; i++) {
+        int client = connectToServer(path);
+        REQUIRE(client >= 0);
+        CHECK_EQ(replyBody(requestOver(client, "scenarios")), "");
+        ::close(client);
+    }
+
+    // Each connect joins the connections that finished before it, so only
+    // the last few can still be waiting
+    int idle = connectToServer(path);
+    int client = connectToServer(path);
+    REQUIRE(idle >= 0);
+    REQUIRE(client >= 0);
+    CHECK(server.getConnectionCount() < 10);
+
+    // Shutdown still answers, and wakes the connection with no request
+    CHECK_EQ(replyBody(requestOver(client, "shutdown")), "stopping\n");
+    ::close(client);
+
+    serving.join();
+    ::close(idle);
+    CHECK_EQ(server.getConnectionCount(), 0u);
+}
+#endif
@@ -0,0 +1,127 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "StaticLine.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    // The sample data files, as a fixed line
+    constexpr StaticStation c_sampleStations[] = {
+        { "Armchair", 654321, 10, "Upholstered Wing Chair" },
+        { "Bed", 123456, 5, "Queen size bed with headboard" },
+        { "Dresser", 56789, 7, "6-Drawer Unit" },
+        { "Nighttable", 887, 5, "Nightstand with 2 drawers" },
+        { "Filing Cabinet", 987654, 5, "3-drawer filing cabinet" },
+        { "Office Chair", 147852, 20, "High-back carpet-rollers" },
+        { "Bookcase", 987, 5, "5-shelf open bookcase" },
+        { "Desk", 459214, 2, "6-foot worktable" }
+    };
+    constexpr StaticLink c_sampleLinks[] = {
+        { "Nighttable", "Desk" },
+        { "Dresser", "Armchair" },
+        { "Filing Cabinet", "Bookcase" },
+        { "Bookcase", nullptr },
+        { "Bed", "Dresser" },
+        { "Office Chair", "Filing Cabinet" },
+        { "Armchair", "Nighttable" },
+        { "Desk", "Office Chair" }
+    };
+    using SampleLine = StaticLine<c_sampleStations, c_sampleLinks>;
+
+    const std::vector<std::string> c_sampleOrders = {
+        "Cornel B.|1-Room Home Office|Office Chair|Desk|Bookcase|Bookcase|Filing Cabinet",
+        "Chris S.|Bedroom|Bed|Armchair|Nighttable|Dresser|Nighttable",
+        "John M.|Kids Bedroom|Bed|Bed|Bed|Bed|Nighttable|Nighttable|Dresser|Desk",
+        "Rania A.|2-Room Home Office and Bedroom|Desk|Office Chair|Filing Cabinet|Bookcase|Bed|Nighttable"
+    };
+
+    void queueStaticTestOrders() {
+        Utilities::setDelimiter('|');
+        for (const auto& record : c_sampleOrders) {
+            g_pending.push_back(CustomerOrder(record));
+        }
+    }
+
+    std::string describeStaticTestResults(const std::vector<Workstation*>& stations, size_t iterations, const std::string& log) {
+        std::ostringstream oss;
+        oss << log << "iterations " << iterations << "\n";
+        for (const auto& order : g_completed) order.display(oss);
+        oss << "--\n";
+        for (const auto& order : g_incomplete) order.display(oss);
+        oss << "--\n";
+        for (const auto* station : stations) {
+            oss << station->getItemName() << " " << station->getSerialNumber() << " " << station->getQuantity() << "\n";
+        }
+        return oss.str();
+    }
+}
+
+// Resolved while compiling
+static_assert(SampleLine::c_route[0] == SampleLine::indexOf("Bed"), "the sample line starts at Bed");
+static_assert(SampleLine::c_route[SampleLine::c_lineLength - 1] == SampleLine::indexOf("Bookcase"), "the sample line ends at Bookcase");
+static_assert(SampleLine::indexOf("Sofa") == SampleLine::c_stationCount, "unknown stations have no index");
+
+TEST_CASE("StaticLine - Route And Stations") {
+    SampleLine line;
+    std::vector<Workstation*> route = line.getLine();
+    REQUIRE_EQ(route.size(), 8u);
+    CHECK_EQ(route.front()->getItemName(), "Bed");
+    CHECK_EQ(route[1]->getItemName(), "Dresser");
+    CHECK_EQ(route.back()->getItemName(), "Bookcase");
+    CHECK_EQ(&line.get<SampleLine::indexOf("Desk")>(), &line.getStations()[7]);
+    CHECK_EQ(line.get<SampleLine::indexOf("Desk")>().getQuantity(), 2u);
+    CHECK_EQ(line.get<SampleLine::indexOf("Desk")>().getSerialNumber(), 459214u);
+}
+
+TEST_CASE("StaticLine - Runs Like A Configured Line") {
+    char originalDelimiter = Utilities::getDelimiter();
+
+    // The same line built the runtime way
+    clearGlobalQueues();
+    Utilities::setDelimiter(',');
+    std::vector<Workstation*> stations;
+    for (const auto& station : c_sampleStations) {
+        stations.push_back(new Workstation(std::string(station.m_itemName) + "," + std::to_string(station.m_serialNumber) + ","
+            + std::to_string(station.m_quantity) + "," + station.m_description));
+    }
+    std::vector<Workstation*> configured;
+    for (const auto& name : { "Bed", "Dresser", "Armchair", "Nighttable", "Desk", "Office Chair", "Filing Cabinet", "Bookcase" }) {
+        for (auto* station : stations) {
+            if (station->getItemName() == name) configured.push_back(station);
+        }
+    }
+    queueStaticTestOrders();
+    LineManager manager(configured);
+    std::ostringstream expectedLog;
+    while (!manager.run(expectedLog));
+    std::string expected = describeStaticTestResults(stations, manager.getIterationCount(), expectedLog.str());
+    for (auto* station : stations) delete station;
+
+    clearGlobalQueues();
+    queueStaticTestOrders();
+    SampleLine line;
+    std::ostringstream log;
+    size_t iterations = line.run(log);
+    std::vector<Workstation*> staticStations;
+    for (auto& station : line.getStations()) staticStations.push_back(&station);
+    CHECK_EQ(describeStaticTestResults(staticStations, iterations, log.str()), expected);
+
+    clearGlobalQueues();
+    queueStaticTestOrders();
+    SampleLine fast;
+    iterations = fast.fastForward();
+    staticStations.clear();
+    for (auto& station : fast.getStations()) staticStations.push_back(&station);
+    CHECK_EQ(describeStaticTestResults(staticStations, iterations, expectedLog.str()), expected);
+
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
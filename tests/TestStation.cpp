@@ -1,8 +1,12 @@
 #include "doctest.h"
 #include "Station.h"
 #include "Utilities.h"
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace seneca;
 
@@ -253,3 +257,86 @@ TEST_CASE("Station - Field Width Adjustment") {
     // Restore delimiter
     Utilities::setDelimiter(originalDelimiter);
 }
+
+TEST_CASE("Station - Construction from Fields") {
+    char originalDelimiter = Utilities::getDelimiter();
+    Utilities::setDelimiter(',');
+    Station::resetWidthField();
+    Station parsed("Desk,123456,5,Office desk with drawers");
+    size_t width = Station::getStaticWidthField();
+
+    Station::resetWidthField();
+    Station station("Desk", 123456, 5, "Office desk with drawers");
+    CHECK_EQ(station.getItemName(), "Desk");
+    CHECK_EQ(station.getQuantity(), 5u);
+    CHECK_EQ(station.getNextSerialNumber(), 123456u);
+    CHECK_EQ(Station::getStaticWidthField(), width);
+
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("Station - Reserve") {
+    Station station("Desk", 100, 5, "Office desk");
+
+    StationReservation first = station.reserve(3);
+    CHECK_EQ(first.m_firstSerial, 100u);
+    CHECK_EQ(first.m_count, 3u);
+
+    // Only what is left is granted
+    StationReservation second = station.reserve(4);
+    CHECK_EQ(second.m_firstSerial, 103u);
+    CHECK_EQ(second.m_count, 2u);
+    CHECK_EQ(station.getQuantity(), 0u);
+    CHECK_EQ(station.getSerialNumber(), 105u);
+
+    CHECK_EQ(station.reserve(1).m_count, 0u);
+    CHECK_EQ(station.reserve(0).m_count, 0u);
+    CHECK_EQ(station.getSerialNumber(), 105u);
+
+    // updateQuantity takes stock but leaves the serial numbers alone
+    station.setQuantity(1);
+    station.updateQuantity();
+    station.updateQuantity();
+    CHECK_EQ(station.getQuantity(), 0u);
+    CHECK_EQ(station.getSerialNumber(), 105u);
+
+    // A copy starts from the same stock and serial number, then goes its own way
+    station.setQuantity(2);
+    Station copy(station);
+    CHECK_EQ(copy.reserve(5).m_count, 2u);
+    CHECK_EQ(station.getQuantity(), 2u);
+    CHECK_EQ(station.reserve(1).m_firstSerial, 105u);
+}
+
+TEST_CASE("Station - Reserve From Several Threads") {
+    const size_t stock = 20000;
+    Station station("Desk", 1000, stock, "Office desk");
+
+    std::vector<std::vector<StationReservation>> granted(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < granted.size(); t++) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; ; i++) {
+                StationReservation reservation = station.reserve(1 + (i + t) % 7);
+                if (reservation.m_count == 0) break;
+                granted[t].push_back(reservation);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // Every unit went out exactly once, each with its own serial number
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (const auto& reservations : granted) {
+        for (const auto& reservation : reservations) ranges.emplace_back(reservation.m_firstSerial, reservation.m_count);
+    }
+    std::sort(ranges.begin(), ranges.end());
+    size_t next = 1000;
+    for (const auto& range : ranges) {
+        CHECK_EQ(range.first, next);
+        next += range.second;
+    }
+    CHECK_EQ(next, 1000 + stock);
+    CHECK_EQ(station.getQuantity(), 0u);
+    CHECK_EQ(station.getSerialNumber(), 1000 + stock);
+}
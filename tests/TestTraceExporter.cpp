@@ -0,0 +1,175 @@
+#include "doctest.h"
+#include "TestHelpers.h"
+#include "TraceExporter.h"
+#include "LineManager.h"
+#include "Workstation.h"
+#include "CustomerOrder.h"
+#include "Utilities.h"
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace seneca;
+using namespace seneca::test;
+
+namespace {
+    size_t countTraceEvents(const std::string& trace, const std::string& text) {
+        size_t count = 0;
+        for (size_t pos = trace.find(text); pos != std::string::npos; pos = trace.find(text, pos + 1)) count++;
+        return count;
+    }
+
+    // The number after `"key":` in one event
+    size_t traceField(const std::string& event, const std::string& key) {
+        size_t pos = event.find("\"" + key + "\":");
+        REQUIRE(pos != std::string::npos);
+        return std::stoul(event.substr(pos + key.size() + 3));
+    }
+
+    // Traces a run where orders queue up behind each other at every station
+    std::string traceQueuedOrders() {
+        std::vector<Workstation*> stations = loadTestStations({
+            "Desk,100,3,Worktable",
+            "Chair,200,9,Office chair",
+            "Lamp,300,9,Desk lamp"
+        }, {
+            "Alice|Office|Desk|Chair|Chair|Lamp",
+            "Bob|Study|Desk|Desk|Lamp",
+            "Carol|Den|Chair|Chair|Chair",
+            "Dave|Hall|Lamp|Lamp",
+            "Erin|Office|Desk|Chair|Lamp|Lamp"
+        });
+
+        std::ostringstream os;
+        {
+            LineManager manager(stations);
+            TraceExporter trace(os, manager);
+            manager.setObserver(&trace);
+            std::ostringstream log;
+            while (!manager.run(log));
+        }
+        deleteTestStations(stations);
+        return os.str();
+    }
+}
+
+TEST_CASE("TraceExporter - Slices, Flows And Instants") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    
+    Utilities::setDelimiter(',');
+    std::vector<Workstation*> stations = {
+        new Workstation("Desk,100,1,Worktable"),
+        new Workstation("Lamp,200,5,Desk lamp")
+    };
+    Utilities::setDelimiter('|');
+    g_pending.push_back(CustomerOrder("Alice \"A\"|Office|Desk|Lamp"));
+    g_pending.push_back(CustomerOrder("Bob|Study|Lamp"));
+    
+    std::ostringstream os;
+    {
+        LineManager manager(stations);
+        TraceExporter trace(os, manager);
+        manager.setObserver(&trace);
+        std::ostringstream log;
+        while (!manager.run(log));
+        trace.finish();
+        trace.finish();
+    }
+    std::string trace = os.str();
+    
+    CHECK(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n") == 0);
+    CHECK(trace.size() > 4);
+    CHECK_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+    CHECK(trace.find("\"tid\":1,\"args\":{\"name\":\"Desk\"}") != std::string::npos);
+    CHECK(trace.find("\"tid\":2,\"args\":{\"name\":\"Lamp\"}") != std::string::npos);
+    
+    // Alice: desk in iteration 1, lamp in iteration 2, with a flow between them
+    CHECK(trace.find("\"name\":\"Alice \\\"A\\\", Office\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":1000,\"args\":{\"order\":1}") != std::string::npos);
+    CHECK(trace.find("\"name\":\"Alice \\\"A\\\", Office\",\"pid\":1,\"tid\":2,\"ts\":1000,\"dur\":1000,\"args\":{\"order\":1}") != std::string::npos);
+    CHECK_EQ(countTraceEvents(trace, "\"ph\":\"X\""), 4u);
+    CHECK_EQ(countTraceEvents(trace, "\"ph\":\"s\""), 2u);
+    CHECK_EQ(countTraceEvents(trace, "\"ph\":\"f\""), 2u);
+    CHECK_EQ(countTraceEvents(trace, "\"name\":\"Filled\""), 3u);
+    
+    for (auto* station : stations) delete station;
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("TraceExporter - Slices On One Track Never Overlap") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    std::string trace = traceQueuedOrders();
+    
+    // Slices on a track must nest or follow each other; an order passing an
+    // idle station with nothing to fill there leaves in the same move pass
+    std::map<size_t, std::vector<std::pair<size_t, size_t>>> tracks;
+    std::istringstream events(trace);
+    std::string event;
+    while (std::getline(events, event)) {
+        if (event.find("\"ph\":\"X\"") == std::string::npos) continue;
+        size_t ts = traceField(event, "ts");
+        tracks[traceField(event, "tid")].emplace_back(ts, ts + traceField(event, "dur"));
+    }
+    REQUIRE_EQ(tracks.size(), 3u);
+    for (auto& track : tracks) {
+        CAPTURE(track.first);
+        std::sort(track.second.begin(), track.second.end());
+        for (size_t i = 1; i < track.second.size(); i++) {
+            const auto& before = track.second[i - 1];
+            const auto& slice = track.second[i];
+            CHECK(slice.first <= slice.second);
+            CHECK((slice.first >= before.second || slice.second <= before.second));
+        }
+    }
+    
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}
+
+TEST_CASE("TraceExporter - Queue Waits Lead Into Service") {
+    char originalDelimiter = Utilities::getDelimiter();
+    clearGlobalQueues();
+    std::string trace = traceQueuedOrders();
+    
+    // (order, track) -> slice start, and each wait as it opens and closes
+    std::map<std::pair<size_t, size_t>, size_t> serviceStarts;
+    std::map<std::pair<size_t, size_t>, size_t> waitStarts;
+    std::vector<std::pair<std::pair<size_t, size_t>, size_t>> waitEnds;
+    std::istringstream events(trace);
+    std::string event;
+    while (std::getline(events, event)) {
+        bool service = event.find("\"ph\":\"X\"") != std::string::npos;
+        bool begin = event.find("\"ph\":\"b\"") != std::string::npos;
+        bool end = event.find("\"ph\":\"e\"") != std::string::npos;
+        if (!service && !begin && !end) continue;
+        std::pair<size_t, size_t> key(traceField(event, service ? "order" : "id"), traceField(event, "tid"));
+        if (service) serviceStarts[key] = traceField(event, "ts");
+        if (begin) {
+            CHECK(event.find("\"cat\":\"queue\"") != std::string::npos);
+            waitStarts[key] = traceField(event, "ts");
+        }
+        if (end) {
+            REQUIRE(waitStarts.count(key) == 1);
+            CHECK(waitStarts[key] < traceField(event, "ts"));
+            waitEnds.emplace_back(key, traceField(event, "ts"));
+        }
+    }
+    
+    // Orders did queue, and every wait ends where that order's service begins
+    CHECK_FALSE(waitEnds.empty());
+    CHECK_EQ(waitEnds.size(), waitStarts.size());
+    for (const auto& wait : waitEnds) {
+        CAPTURE(wait.first.first);
+        CAPTURE(wait.first.second);
+        REQUIRE(serviceStarts.count(wait.first) == 1);
+        CHECK_EQ(serviceStarts[wait.first], wait.second);
+    }
+    CHECK(trace.find("\"name\":\"Desk queue\"") != std::string::npos);
+    
+    clearGlobalQueues();
+    Utilities::setDelimiter(originalDelimiter);
+}